@@ -13,6 +13,7 @@
 typedef struct CollisionInfo CollisionInfo;
 typedef struct EC_Collider EC_Collider;
 typedef struct MeshBVH MeshBVH;
+typedef struct Heightfield Heightfield;
 typedef void (*OnCollisionCallback)(EC_Collider *self, CollisionInfo *info);
 
 // -------------------------
@@ -38,17 +39,24 @@ typedef struct
 typedef struct
 {
     Mesh *mesh;
-    // Cached BVH pointer for fast access (points to mesh->bvh)
+    // Cached BVH pointer for fast access (points to mesh->bvh, set on creation)
     // This avoids dereferencing mesh->bvh repeatedly during raycasts
     struct MeshBVH *bvh;
 } MeshCollider;
 
+typedef struct
+{
+    /// @brief Owned by the collider, freed with it. Samples stay owned by whoever created the heightfield.
+    Heightfield *heightfield;
+} HeightfieldCollider;
+
 typedef union
 {
     BoxCollider box;
     SphereCollider sphere;
     CapsuleCollider capsule;
     MeshCollider mesh;
+    HeightfieldCollider heightfield;
 } ColliderData;
 
 typedef enum
@@ -56,7 +64,8 @@ typedef enum
     EC_COLLIDER_BOX,
     EC_COLLIDER_SPHERE,
     EC_COLLIDER_CAPSULE,
-    EC_COLLIDER_MESH
+    EC_COLLIDER_MESH,
+    EC_COLLIDER_HEIGHTFIELD
 } EC_Collider_T;
 
 /**
@@ -73,6 +82,7 @@ struct EC_Collider
     Transform *transform;
     
     // Physics properties
+    /// @brief Only reports OnCollisionEnter and OnCollisionExit, nothing collides with it. Read when the rigidbody registers.
     bool isTrigger;
     /// @brief Local space offset from entity position
     V3 offset;
@@ -85,6 +95,7 @@ struct EC_Collider
     
     // -------------------------
     // COLLISION EVENTS
+    // Recorded during the physics step and called once it is done, so physics state is consistent inside them
     // -------------------------
     
     /**
@@ -107,10 +118,6 @@ struct EC_Collider
      * @note Set to NULL if you don't need this event
      */
     OnCollisionCallback OnCollisionExit;
-    // Internal collision tracking
-    struct EC_Collider **currentCollisions;
-    int currentCollisions_size;
-    int currentCollisions_capacity;
 
 #ifdef DEBUG_COLLIDERS
     // Debug-only data for visualization
@@ -13,6 +13,8 @@
 #include "game/creature/stomach.h"
 // Vision
 #include "game/creature/vision.h"
+// Movement
+#include "physics/character_controller.h"
 
 // -------------------------
 // Types
@@ -56,6 +58,8 @@ struct EC_Creature
     Stomach stomach;
     // Vision
     CreatureVision vision;
+    // Movement
+    CharacterController characterController;
     // Caching
     V3 previousPos;
 };
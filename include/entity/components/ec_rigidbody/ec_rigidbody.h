@@ -7,6 +7,7 @@
 // Collider
 #include "entity/components/ec_collider/ec_collider.h"
 // Physics
+#include "physics/rigidbody_store.h"
 #include "physics/physics-manager.h"
 
 // -------------------------
@@ -15,40 +16,24 @@
 
 typedef struct EC_Collider EC_Collider;
 
-typedef struct RigidBodyConstraints
-{
-    bool freezePositionX;
-    bool freezePositionY;
-    bool freezePositionZ;
-    bool freezeRotationX;
-    bool freezeRotationY;
-    bool freezeRotationZ;
-} RigidBodyConstraints;
-
+/**
+ * @brief Links an entity to its simulated state. Velocities, forces and the other per-body fields live in the
+ * physics manager's RigidBodyStore, use the PhysicsManager_ functions to read or change them.
+ */
 typedef struct EC_RigidBody
 {
     Component *component;
     // Collider
     EC_Collider *ec_collider;
-    float mass;
-    bool useGravity;
-    bool isKinematic;
     bool *isStatic;
-    // Transform
-    V3 w_pos;
-    Quaternion w_rot;
-    // Velocity
-    V3 velocity;
-    V3 angularVelocity;
-    V3 forceAccum;
-    V3 torqueAccum;
-    float linearDamping;
-    float angularDamping;
-    // Sleeping system
-    bool isSleeping;
-    float sleepTimer;
-    // Constraints
-    RigidBodyConstraints constraints;
+    // State in PhysicsManager::bodies (RIGIDBODY_HANDLE_NONE when not registered)
+    uint32_t handle;
+    // Broadphase proxy (SAP_PROXY_NONE when not registered)
+    uint32_t broadphaseProxy;
+    // Raycast tree item (SCENE_BVH_NONE when not registered)
+    uint32_t raycastProxy;
+    // Overlap grid item (SPATIAL_HASH_NONE when not registered)
+    uint32_t overlapProxy;
 } EC_RigidBody;
 
 // ------------------------- 
@@ -4,6 +4,7 @@
 #include "utilities/math/v2.h"
 #include "utilities/math/v3.h"
 #include "utilities/noise/noise.h"
+#include "physics/heightfield.h"
 #include "entity/components/ec_mesh_renderer/ec_mesh_renderer.h"
 #include "entity/transform.h"
 
@@ -11,6 +12,8 @@ typedef struct {
     Component *component;
     EC_MeshRenderer* ec_meshRenderer_island;
     Noise* noise;
+    // Owned by the island's collider
+    Heightfield* heightfield;
 } EC_Island;
 
 EC_Island* Prefab_Island(Entity* parent, TransformSpace TS, V3 position, Quaternion rotation, V3 scale, V3 meshScale);
@@ -87,6 +87,11 @@ void T_Print_LMatrix(Transform *transform);
 // Getters
 // -------------------------
 
+/**
+ * @brief Refresh the cached world data of the transform and its dirty ancestors now.
+ * Until the next setter call, the getters below then only read, which makes them safe to call from several threads.
+ */
+void T_Clean(Transform *transform);
 V3 T_WPos(Transform *transform);
 Quaternion T_WRot(Transform *transform);
 V3 T_WSca(Transform *transform);
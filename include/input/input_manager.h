@@ -94,6 +94,7 @@ void InputManager_Select(InputManager* manager);
 // Creation & Freeing
 // -------------------------
 
+/// @param window Window whose events are listened to, NULL to receive no input
 InputManager *InputManager_Create(GLFWwindow *window, char *name);
 void InputManager_Free(InputManager *manager);
 
@@ -120,6 +121,15 @@ void InputManager_PushContext(InputContext *context);
 void InputManager_PopContext(InputContext *context);
 void InputManager_ResetInputs();
 
+// ----------------------------------------
+// Events
+// ----------------------------------------
+
+/// @brief Apply an event to the contexts on the stack, like the window's callbacks. action is GLFW_PRESS, GLFW_REPEAT or GLFW_RELEASE
+void InputManager_OnKey(int key, int action);
+void InputManager_OnButton(int button, int action);
+void InputManager_OnMotion(double xpos, double ypos);
+
 
 // ----------------------------------------
 // Input Listener 
@@ -0,0 +1,87 @@
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+// C
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------
+// Types
+// -------------------------
+
+typedef enum InputRecorderMode
+{
+    INPUT_RECORDER_RECORD,
+    INPUT_RECORDER_REPLAY,
+} InputRecorderMode;
+
+typedef enum InputEventType
+{
+    INPUT_EVENT_KEY,
+    INPUT_EVENT_BUTTON,
+    INPUT_EVENT_MOTION,
+} InputEventType;
+
+/**
+ * @brief Writes the RNG seed and every input event of a run to a binary file, tagged with the frame it arrived in,
+ * or feeds such a recording back through the input manager at the same frames.
+ * A replay only matches its recording when every frame advances time by the same amount, as the fixed clock does.
+ */
+typedef struct InputRecorder
+{
+    InputRecorderMode mode;
+    /// @brief Seed of rand(), read from the recording when replaying
+    uint32_t seed;
+    /// @brief Index of the current frame
+    uint32_t frame;
+    /// @brief Frames the recording spans, written when it is closed or counted from its events when it was not
+    uint32_t frames;
+    // Recording
+    FILE *file;
+    // Replay, the whole recording is read up front
+    size_t data_size;
+    size_t data_offset;
+    unsigned char *data;
+} InputRecorder;
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+/**
+ * @brief Open a recording and select the recorder
+ * @param seed Seed written to a new recording, ignored when replaying
+ * @return NULL if the file cannot be opened or is not a recording
+ */
+InputRecorder *InputRecorder_Create(const char *path, InputRecorderMode mode, uint32_t seed);
+/**
+ * @brief Close the recording, a new one gets its frame count written
+ */
+void InputRecorder_Free(InputRecorder *recorder);
+
+// -------------------------
+// Frames
+// -------------------------
+
+/**
+ * @brief Replay the current frame's events, call where the window's events are polled
+ */
+void InputRecorder_BeginFrame();
+void InputRecorder_EndFrame();
+/// @return Whether a replay went past its last frame
+bool InputRecorder_IsFinished();
+
+// -------------------------
+// Recording
+// -------------------------
+
+/**
+ * @brief Append an event from the window to the current frame, does nothing unless recording
+ * @param code Key or button, unused for motions
+ * @param x Cursor position, unused for keys and buttons
+ */
+void InputRecorder_Record(InputEventType type, int code, int action, double x, double y);
+
+#endif
@@ -3,6 +3,7 @@
 
 #include "utilities/math/v3.h"
 #include <stdint.h>
+#include <stdbool.h>
 #include "ui/window.h"
 #define GLFW_INCLUDE_NONE
 #include <glad/glad.h>
@@ -15,11 +16,15 @@
 extern float DeltaTime;
 extern float FixedDeltaTime;
 extern float PerceptronTime;
+/// @brief Fraction of a fixed step elapsed since the last one ran, in [0, 1]
+extern float FixedAlpha;
 
 // -------------------------
 // Window
 // -------------------------
 extern MyWindowConfig WindowConfig;
+/// @brief Running without a window or OpenGL context (--headless): nothing is uploaded to the GPU or rendered
+extern bool Headless;
 
 // -------------------------
 // World Axis
@@ -0,0 +1,76 @@
+#ifndef CHARACTER_CONTROLLER_H
+#define CHARACTER_CONTROLLER_H
+
+// Math
+#include "utilities/math/v3.h"
+#include "entity/transform.h"
+// Ground
+#include "physics/heightfield.h"
+// C
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct EC_Collider EC_Collider;
+
+// -------------------------
+// Types
+// -------------------------
+
+/**
+ * @brief Moves a vertical capsule standing on its feet through the static world, without the rigidbody solver.
+ * Walls are slid along, obstacles up to stepHeight are stepped onto and the character stays snapped to the ground
+ * while walking down slopes.
+ * @note Obstacles are not swept against a rounded capsule: static colliders are taken as their world AABBs and the
+ * capsule as its square footprint, radius from its center along X and Z, so corners block a little early.
+ */
+typedef struct CharacterController
+{
+    // Capsule, from the feet up
+    float radius;
+    float height;
+    /// @brief Cosine of the steepest slope the character can walk up
+    float slopeLimit;
+    /// @brief Obstacles reaching at most this far above the feet are stepped onto
+    float stepHeight;
+    /// @brief Ground at most this far below the feet is snapped to while grounded
+    float snapDistance;
+    /// @brief Layers (1 << layer) of the static colliders that block the character
+    uint32_t layerMask;
+    /// @brief The character's own collider, never an obstacle
+    EC_Collider *self;
+    // Ground, sampled under the feet (NULL when there is none)
+    const Heightfield *ground;
+    /// @brief Transform the ground's samples are relative to, NULL for world space. May be moved, turned and scaled,
+    /// a tilted ground is raycast rather than sampled.
+    Transform *groundTransform;
+    // State
+    bool isGrounded;
+    V3 groundNormal;
+    /// @brief Vertical speed from gravity while airborne
+    float fallSpeed;
+} CharacterController;
+
+// -------------------------
+// Initialization
+// -------------------------
+
+/**
+ * @param slopeLimit Steepest walkable slope, in degrees
+ */
+void CharacterController_Init(CharacterController *controller, EC_Collider *self, float radius, float height, float slopeLimit,
+                              float stepHeight, uint32_t layerMask);
+void CharacterController_SetGround(CharacterController *controller, const Heightfield *ground, Transform *groundTransform);
+
+// -------------------------
+// Movement
+// -------------------------
+
+/**
+ * @brief Move the feet by displacement, blocked and lifted by the static world, then apply gravity unless grounded
+ * @param position World position of the feet
+ * @param deltaTime Time the move spans, used for gravity
+ * @return New world position of the feet
+ */
+V3 CharacterController_Move(CharacterController *controller, V3 position, V3 displacement, float deltaTime);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef CONTACT_CACHE_H
+#define CONTACT_CACHE_H
+
+// C
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct EC_Collider EC_Collider;
+
+// -------------------------
+// Types
+// -------------------------
+
+/**
+ * @brief A pair of bodies that touched during the last step. Keyed on the bodies' RigidBodyStore handles,
+ * so the table layout, and with it the order exits are reported in, does not depend on where bodies were allocated.
+ */
+typedef struct ContactEntry
+{
+    /// @brief (lower handle << 32) | higher handle, or one of the CONTACT_KEY_ markers of contact_cache.c
+    uint64_t key;
+    EC_Collider *colliderA;
+    EC_Collider *colliderB;
+    /// @brief Last step the pair touched in
+    uint32_t stamp;
+} ContactEntry;
+
+/**
+ * @brief Open-addressing hash set of touching pairs with linear probing.
+ * Pairs touched during a step and missing from the table started touching, pairs left with an old stamp stopped.
+ */
+typedef struct ContactCache
+{
+    // Slots (count is a power of two)
+    size_t entries_capacity;
+    ContactEntry *entries;
+    /// @brief Live pairs
+    size_t size;
+    /// @brief Live pairs and tombstones, bounds the probe lengths
+    size_t used;
+    uint32_t stamp;
+} ContactCache;
+
+/**
+ * @brief Called once per pair that was not touched this step
+ * @return false to keep the pair, e.g. when it was only skipped because both bodies are asleep
+ */
+typedef bool (*ContactEndedCallback)(void *context, uint32_t bodyA, uint32_t bodyB, EC_Collider *colliderA, EC_Collider *colliderB);
+
+// -------------------------
+// Steps
+// -------------------------
+
+/**
+ * @brief Start a step, pairs not touched until ContactCache_EndStep count as ended
+ */
+void ContactCache_BeginStep(ContactCache *cache);
+/**
+ * @brief Record that two bodies touch this step
+ * @return true if they already touched last step, false if the contact just started
+ */
+bool ContactCache_Touch(ContactCache *cache, uint32_t bodyA, uint32_t bodyB, EC_Collider *colliderA, EC_Collider *colliderB);
+/**
+ * @brief Remove every pair that was not touched this step in one pass over the table, unless onEnded keeps it.
+ * @note onEnded may call ContactCache_RemoveBody
+ */
+void ContactCache_EndStep(ContactCache *cache, ContactEndedCallback onEnded, void *context);
+/**
+ * @brief Forget every pair of a body without reporting them, call before its handle gets reused
+ */
+void ContactCache_RemoveBody(ContactCache *cache, uint32_t body);
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+ContactCache *ContactCache_Create();
+void ContactCache_Free(ContactCache *cache);
+
+#endif
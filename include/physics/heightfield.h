@@ -0,0 +1,84 @@
+#ifndef HEIGHTFIELD_H
+#define HEIGHTFIELD_H
+
+#include "utilities/math/v3.h"
+#include "physics/aabb.h"
+#include <stddef.h>
+#include <stdbool.h>
+
+// -------------------------
+// Types
+// -------------------------
+
+/**
+ * @brief Min and max height of a square block of cells
+ */
+typedef struct HeightfieldBlock
+{
+    float min;
+    float max;
+} HeightfieldBlock;
+
+/**
+ * @brief One level of the min/max pyramid, level i groups 2^i x 2^i cells per block
+ */
+typedef struct HeightfieldLevel
+{
+    int width;
+    int height;
+    HeightfieldBlock *blocks;
+} HeightfieldLevel;
+
+/**
+ * @brief Regular grid of height samples collided against directly, without building triangles.
+ * Sample (x, z) sits at origin + (x * spacing.x, map[x][z] * spacing.y, z * spacing.z), and each cell is split
+ * into the triangles (x, z), (x + 1, z), (x, z + 1) and (x, z + 1), (x + 1, z), (x + 1, z + 1).
+ * @note The samples are not copied, map must outlive the heightfield. Call Heightfield_Update after it changed.
+ */
+typedef struct Heightfield
+{
+    // Samples (borrowed, column-major like Noise::map)
+    float *const *map;
+    int width;
+    int height;
+    V3 origin;
+    V3 spacing;
+    // Bounds
+    AABB bounds;
+    // Pyramid, levels[0] groups 2x2 cells, single cells are read straight from the map
+    size_t levels_size;
+    HeightfieldLevel *levels;
+} Heightfield;
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+/**
+ * @param map Column-major samples, map[x][z] with x < width and z < height
+ */
+Heightfield *Heightfield_Create(float *const *map, int width, int height, V3 origin, V3 spacing);
+void Heightfield_Free(Heightfield *heightfield);
+/**
+ * @brief Point the heightfield at new samples and rebuild its pyramid
+ */
+void Heightfield_Update(Heightfield *heightfield, float *const *map, int width, int height);
+
+// -------------------------
+// Queries
+// -------------------------
+
+/**
+ * @brief Height of the surface above (x, z), interpolated on the same triangles raycasts hit
+ * @return false if (x, z) is outside the heightfield
+ */
+bool Heightfield_GetHeight(const Heightfield *heightfield, float x, float z, float *outHeight);
+
+/**
+ * @brief Closest hit along the ray. Walks the pyramid with a 2D DDA, skipping blocks the ray passes over or under.
+ * @param direction Need not be normalized, distances are in multiples of it
+ */
+bool Heightfield_Raycast(const Heightfield *heightfield, V3 origin, V3 direction, float maxDistance,
+                         float *outDistance, V3 *outNormal);
+
+#endif
@@ -11,54 +11,106 @@
 // Types
 // -------------------------
 
-typedef struct BVHTriangle BVHTriangle;
+#define MESH_BVH_MAX_BINS 32
+#define MESH_BVH_MAX_DEPTH 64
+#define MESH_BVH_STACK_SIZE (MESH_BVH_MAX_DEPTH + 1)
+/// @brief Refits rebuild the tree once its SAH cost grew past this factor of the cost it was built with
+#define MESH_BVH_REBUILD_COST_FACTOR 2.0f
+/// @brief Meshes with at least this many triangles have their tree cached on disk, keyed by a hash of their content
+#define MESH_BVH_CACHE_MIN_TRIANGLES 4096
+#define MESH_BVH_CACHE_DIR "cache"
+/// @brief Subtrees with fewer triangles are built serially, larger ones split their children across the task pool
+#define MESH_BVH_PARALLEL_MIN_TRIANGLES 16384
+
 typedef struct BVHNode BVHNode;
 typedef struct MeshBVH MeshBVH;
+typedef struct MeshBVHWide MeshBVHWide;
 
 /**
- * @brief Represents a triangle in the BVH with precomputed data
+ * @brief BVH Node - can be either leaf or internal node. 32 bytes, stored in depth-first order in MeshBVH::nodes.
+ * @note Internal nodes (count == 0): the left child is the next node, the right child is offset nodes further.
+ * Leaves (count > 0): offset is the index of their first triangle in MeshBVH::triangles.
+ * Every subtree references a contiguous range of MeshBVH::triangles.
  */
-struct BVHTriangle
+struct BVHNode
 {
-    uint32_t indices[3];
-    V3 vertices[3];
-    V3 normal;
-    V3 centroid;
-    AABB bounds;
+    V3 min;
+    uint32_t offset;
+    V3 max;
+    uint32_t count;
 };
 
-/**
- * @brief BVH Node - can be either leaf or internal node
- */
-struct BVHNode
+typedef enum MeshBVHBuildQuality
 {
-    AABB bounds;
-
-    // For internal nodes
-    struct BVHNode *left;
-    struct BVHNode *right;
+    /// @brief Only evaluate splits along the axis where triangle centroids are most spread out
+    MESH_BVH_QUALITY_FAST,
+    /// @brief Evaluate splits along all three axes, slower to build but cheaper to traverse
+    MESH_BVH_QUALITY_HIGH
+} MeshBVHBuildQuality;
 
-    // For leaf nodes
-    BVHTriangle *triangles;
-    uint32_t triangle_count;
+typedef enum MeshBVHTriangleLayout
+{
+    /// @brief Leaves only reference MeshBVH::triangles, raycasts read the vertex positions from the mesh
+    MESH_BVH_TRIANGLES_COMPACT,
+    /// @brief The wide tree also keeps every triangle as a first vertex and two edges, 40 more bytes per triangle,
+    /// so raycasts never touch the mesh
+    MESH_BVH_TRIANGLES_EDGES
+} MeshBVHTriangleLayout;
 
-    bool is_leaf;
-};
+/**
+ * @brief Parameters of the binned SAH builder
+ */
+typedef struct MeshBVHBuildSettings
+{
+    /// @brief Nodes with this many triangles or fewer become leaves unless splitting is cheaper
+    uint32_t max_triangles_per_leaf;
+    /// @brief Number of bins per axis when evaluating split planes (2 to MESH_BVH_MAX_BINS)
+    uint32_t bin_count;
+    MeshBVHBuildQuality quality;
+    MeshBVHTriangleLayout layout;
+    /// @brief Relative cost of visiting a node, against testing a triangle
+    float traversal_cost;
+    float intersection_cost;
+} MeshBVHBuildSettings;
 
 /**
  * @brief Complete BVH structure for a mesh
  */
 struct MeshBVH
 {
-    BVHNode *root;
-    BVHTriangle *triangles;
+    /// @brief Root first, total_nodes entries. Points into cache_mapping when loaded from the cache.
+    BVHNode *nodes;
+    /// @brief Cache file the nodes were loaded from, NULL when built
+    void *cache_mapping;
+    size_t cache_mapping_size;
+    /// @brief Mesh triangle index of every slot, ordered so that every leaf references a contiguous range.
+    /// Points into cache_mapping when loaded from the cache.
+    uint32_t *triangles;
     uint32_t triangle_count;
-    uint32_t max_triangles_per_leaf;
+    /// @brief Vertex positions are read from the mesh rather than copied, it owns the BVH
+    const Mesh *mesh;
+    MeshBVHBuildSettings settings;
+    /// @brief Collapsed copy of the tree used by raycasts, see mesh_bvh_wide.h
+    MeshBVHWide *wide;
+    /// @brief Leaf node of every mesh triangle, built by the first partial refit. NULL until then.
+    uint32_t *triangle_leaves;
+    /// @brief One flag per node, set while a partial refit walks up from the edited leaves
+    bool *dirty_nodes;
+    /// @brief Triangles using each vertex of an indexed mesh, those of vertex v start at vertex_triangle_offsets[v]
+    /// and end at vertex_triangle_offsets[v + 1]. Built by the first partial MeshBVH_RefitVertices over vertex_count
+    /// vertices, dropped when indices may have changed. NULL until then.
+    uint32_t *vertex_triangle_offsets;
+    uint32_t *vertex_triangles;
+    uint32_t vertex_count;
 
     // Statistics (for debugging/optimization)
     uint32_t total_nodes;
     uint32_t leaf_nodes;
     uint32_t max_depth;
+    /// @brief Expected cost of a ray traversal according to the surface area heuristic
+    float sah_cost;
+    /// @brief sah_cost right after the last build, refits compare against it
+    float build_sah_cost;
 };
 
 // -------------------------
@@ -71,8 +123,8 @@ typedef struct
     float distance;
     V3 point;
     V3 normal;
+    /// @brief Index of the triangle in the mesh
     uint32_t triangle_index;
-    BVHTriangle *triangle;
 } BVHRaycastHit;
 
 // -------------------------
@@ -80,12 +132,24 @@ typedef struct
 // -------------------------
 
 /**
- * @brief Create a BVH for the given mesh
+ * @brief Quick to build, 16 bins on the longest axis, up to 8 triangles per leaf, compact triangles
+ */
+MeshBVHBuildSettings MeshBVHBuildSettings_Default();
+/**
+ * @brief Slower to build but faster to raycast, 32 bins on every axis, up to 4 triangles per leaf, precomputed edges
+ */
+MeshBVHBuildSettings MeshBVHBuildSettings_HighQuality();
+
+/**
+ * @brief Create a BVH for the given mesh using a binned surface area heuristic.
+ * Large meshes map their tree from MESH_BVH_CACHE_DIR when a cache with the same content hash exists,
+ * and write it there otherwise. The top levels are built on the selected task pool, if any; the tree
+ * is the same as a serial build.
  * @param mesh The mesh to create BVH for
- * @param max_triangles_per_leaf Maximum triangles per leaf node (4-16 recommended)
+ * @param settings Build parameters, see MeshBVHBuildSettings_Default
  * @return Pointer to created BVH or NULL on failure
  */
-MeshBVH *MeshBVH_Create(Mesh *mesh, uint32_t max_triangles_per_leaf);
+MeshBVH *MeshBVH_Create(Mesh *mesh, MeshBVHBuildSettings settings);
 
 /**
  * @brief Free a BVH and all its resources
@@ -93,15 +157,47 @@ MeshBVH *MeshBVH_Create(Mesh *mesh, uint32_t max_triangles_per_leaf);
  */
 void MeshBVH_Free(MeshBVH *bvh);
 
+// -------------------------
+// Deformation
+// -------------------------
+
+/**
+ * @brief Update the tree after the mesh's vertex positions changed. Only the leaves holding an edited triangle read
+ * the positions again, straight from the mesh, then their ancestors are refit bottom-up in one O(nodes) sweep.
+ * The wide tree is refit in place the same way, only the packets of edited leaves are rewritten.
+ * The first partial refit maps triangles to leaves, a refit of the whole mesh skips the map. Rebuilds from scratch
+ * when the refit pushed the SAH cost past MESH_BVH_REBUILD_COST_FACTOR, or when the mesh's triangle count changed.
+ * @param mesh The mesh the BVH was built from, with its vertices already updated
+ * @param first_triangle First edited triangle, in mesh order. Its indices may have changed too.
+ * @param triangle_count Number of edited triangles, clamped to the mesh (UINT32_MAX for all). Nothing is refit when empty.
+ * @return True if the tree was rebuilt
+ */
+bool MeshBVH_Refit(MeshBVH *bvh, Mesh *mesh, uint32_t first_triangle, uint32_t triangle_count);
+/**
+ * @brief Same as MeshBVH_Refit for a range of edited vertices: only the leaves of triangles using them are refit.
+ * Indexed meshes list the triangles of every vertex on the first partial call, 4 bytes per vertex and 12 per triangle.
+ * @param first_vertex First edited vertex
+ * @param vertex_count Number of edited vertices, clamped to the mesh (UINT32_MAX for all)
+ * @return True if the tree was rebuilt
+ */
+bool MeshBVH_RefitVertices(MeshBVH *bvh, Mesh *mesh, uint32_t first_vertex, uint32_t vertex_count);
+
+/**
+ * @brief Current positions of a mesh triangle's vertices
+ * @param triangle Index of the triangle in the mesh, as stored in MeshBVH::triangles
+ */
+void MeshBVH_GetTriangle(const MeshBVH *bvh, uint32_t triangle, V3 *out_vertices);
+
 // -------------------------
 // Raycast Operations
 // -------------------------
 
 /**
- * @brief Perform raycast against BVH
+ * @brief Perform raycast against BVH. The BVH is in mesh-local space, so is the ray.
  * @param bvh The BVH to test against
- * @param origin Ray origin in world space
- * @param direction Ray direction (should be normalized)
+ * @param origin Ray origin in mesh-local space
+ * @param direction Ray direction in mesh-local space, not normalized: distances are measured in multiples of it,
+ * which keeps them in world units when the ray was transformed from world space
  * @param max_distance Maximum ray distance
  * @param hit Output structure for hit information
  * @return True if ray hit something, false otherwise
@@ -118,14 +214,4 @@ bool MeshBVH_Raycast(MeshBVH *bvh, V3 origin, V3 direction, float max_distance,
  */
 void MeshBVH_PrintStats(MeshBVH *bvh);
 
-/**
- * @brief Update BVH triangles after mesh transformation
- * @param bvh The BVH to update
- * @param mesh Source mesh
- * @param transform Transformation to apply to vertices
- * @note Call this when the mesh transform changes significantly
- */
-void MeshBVH_UpdateTransform(MeshBVH *bvh, Mesh *mesh, V3 worldPos, V3 worldScale,
-                             V3 right, V3 up, V3 forward, V3 offset);
-
 #endif // MESH_BVH_H
\ No newline at end of file
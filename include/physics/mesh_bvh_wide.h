@@ -0,0 +1,116 @@
+#ifndef MESH_BVH_WIDE_H
+#define MESH_BVH_WIDE_H
+
+#include "physics/mesh_bvh.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------
+// Types
+// -------------------------
+
+/**
+ * @brief Children per wide node, picked from the instruction sets the compiler targets:
+ * 8 with AVX (e.g. -march=native on recent x86), 4 with SSE2, 4 with plain scalar loops otherwise.
+ */
+#if defined(__AVX__)
+#define MESH_BVH_WIDTH 8
+#define MESH_BVH_SIMD "AVX"
+#elif defined(__SSE2__) || defined(_M_X64)
+#define MESH_BVH_WIDTH 4
+#define MESH_BVH_SIMD "SSE2"
+#else
+#define MESH_BVH_WIDTH 4
+#define MESH_BVH_SIMD "scalar"
+#endif
+
+/// @brief Child slot holding a nested wide node rather than triangle packets
+#define MESH_BVH_WIDE_INTERNAL 0
+
+/**
+ * @brief Node of the collapsed tree, child bounds stored per axis so one ray is tested against every child at once.
+ * Unused slots have NaN bounds, which never pass the slab test.
+ * @note child[i] is a node index when count[i] == MESH_BVH_WIDE_INTERNAL. Otherwise it is the first of count[i] packets
+ * with MESH_BVH_TRIANGLES_EDGES, or the first of count[i] slots of MeshBVH::triangles with compact triangles.
+ */
+typedef struct BVHWideNode
+{
+    float min_x[MESH_BVH_WIDTH];
+    float min_y[MESH_BVH_WIDTH];
+    float min_z[MESH_BVH_WIDTH];
+    float max_x[MESH_BVH_WIDTH];
+    float max_y[MESH_BVH_WIDTH];
+    float max_z[MESH_BVH_WIDTH];
+    uint32_t child[MESH_BVH_WIDTH];
+    uint32_t count[MESH_BVH_WIDTH];
+} BVHWideNode;
+
+/**
+ * @brief MESH_BVH_WIDTH triangles of a leaf in structure-of-arrays form, ready for Möller-Trumbore.
+ * Padding lanes have zero edges, they are rejected as parallel to every ray.
+ * Stored with MESH_BVH_TRIANGLES_EDGES, gathered from the mesh during the raycast otherwise.
+ */
+typedef struct BVHTrianglePacket
+{
+    float v0_x[MESH_BVH_WIDTH];
+    float v0_y[MESH_BVH_WIDTH];
+    float v0_z[MESH_BVH_WIDTH];
+    float e1_x[MESH_BVH_WIDTH];
+    float e1_y[MESH_BVH_WIDTH];
+    float e1_z[MESH_BVH_WIDTH];
+    float e2_x[MESH_BVH_WIDTH];
+    float e2_y[MESH_BVH_WIDTH];
+    float e2_z[MESH_BVH_WIDTH];
+    /// @brief Index of the triangle in the mesh, UINT32_MAX for padding
+    uint32_t triangle[MESH_BVH_WIDTH];
+} BVHTrianglePacket;
+
+/**
+ * @brief Binary MeshBVH collapsed into MESH_BVH_WIDTH-ary nodes, root first, depth-first order.
+ * Subtrees of at most MESH_BVH_WIDTH triangles are never opened, they become a single packet.
+ */
+struct MeshBVHWide
+{
+    /// @brief Binary tree the wide one was collapsed from, compact leaves read their triangles through it
+    const MeshBVH *bvh;
+    BVHWideNode *nodes;
+    /// @brief Binary node behind every child slot, MESH_BVH_WIDTH per wide node, UINT32_MAX for unused slots.
+    /// Lets a refit update the wide tree in place.
+    uint32_t *sources;
+    uint32_t nodes_size;
+    uint32_t nodes_capacity;
+    /// @brief NULL with compact triangles
+    BVHTrianglePacket *packets;
+    uint32_t packets_size;
+    uint32_t packets_capacity;
+};
+
+// -------------------------
+// Creation & Destruction
+// -------------------------
+
+/**
+ * @brief Collapse a built binary BVH. Children with the largest surface area are opened first.
+ * With MESH_BVH_TRIANGLES_EDGES, packets are filled from the vertex positions of the BVH's mesh.
+ * @return NULL if the BVH has no nodes
+ */
+MeshBVHWide *MeshBVHWide_Create(const MeshBVH *bvh);
+/**
+ * @brief Update the wide tree in place after the binary BVH was refit. The shape picked by the collapse is kept,
+ * only child bounds are copied again and only the packets of edited leaves are read from the mesh.
+ * @param dirty Flag per binary node, set on every refit node, NULL when the whole tree was refit
+ */
+void MeshBVHWide_Refit(MeshBVHWide *wide, const MeshBVH *bvh, const bool *dirty);
+void MeshBVHWide_Free(MeshBVHWide *wide);
+
+// -------------------------
+// Raycast Operations
+// -------------------------
+
+/**
+ * @brief Same contract as MeshBVH_Raycast, hit must come in initialized with hit->distance as the max distance.
+ * Stored packets hold everything a hit needs, compact leaves gather theirs from the mesh.
+ */
+bool MeshBVHWide_Raycast(const MeshBVHWide *wide, V3 origin, V3 direction, BVHRaycastHit *hit);
+
+#endif // MESH_BVH_WIDE_H
@@ -8,6 +8,18 @@ typedef struct ELayer ELayer;
 #include "entity/components/ec_rigidbody/ec_rigidbody.h"
 // Bounds
 #include "physics/aabb.h"
+// Simulation state
+#include "physics/rigidbody_store.h"
+// Collision events
+#include "physics/contact_cache.h"
+// Broadphase
+#include "physics/sweep_and_prune.h"
+// Raycasting
+#include "physics/scene_bvh.h"
+// Overlap queries
+#include "physics/spatial_hash.h"
+// Threading
+#include <pthread.h>
 
 typedef struct EC_RigidBody EC_RigidBody;
 typedef struct EC_Collider EC_Collider;
@@ -25,6 +37,70 @@ typedef struct CollisionInfo
     float penetration;
 } CollisionInfo;
 
+typedef enum CollisionEventType
+{
+    COLLISION_EVENT_ENTER,
+    COLLISION_EVENT_STAY,
+    COLLISION_EVENT_EXIT,
+    /// @brief Dropped because one of the colliders was removed before dispatch
+    COLLISION_EVENT_NONE
+} CollisionEventType;
+
+/**
+ * @brief A collision event recorded during the step and dispatched to both colliders once the step is done
+ * @note normal points from colliderA towards colliderB, colliderA receives it negated
+ */
+typedef struct CollisionEvent
+{
+    CollisionEventType type;
+    EC_Collider *colliderA;
+    EC_Collider *colliderB;
+    V3 contactPoint;
+    V3 normal;
+    float penetration;
+} CollisionEvent;
+
+// -------------------------
+// Commands
+// -------------------------
+
+typedef enum PhysicsCommandType
+{
+    PHYSICS_COMMAND_ADD_FORCE,
+    PHYSICS_COMMAND_ADD_TORQUE,
+    PHYSICS_COMMAND_SET_VELOCITY,
+    PHYSICS_COMMAND_SET_ANGULAR_VELOCITY,
+    /// @brief Dropped because the body was removed before the step started
+    PHYSICS_COMMAND_NONE
+} PhysicsCommandType;
+
+/**
+ * @brief A write to a body's simulation state, queued by gameplay code and applied when the next step starts
+ */
+typedef struct PhysicsCommand
+{
+    PhysicsCommandType type;
+    /// @brief RigidBodyStore handle of the body
+    uint32_t body;
+    V3 value;
+} PhysicsCommand;
+
+// -------------------------
+// Snapshots
+// -------------------------
+
+/**
+ * @brief Local pose of every body, in store order, as it was at the end of a step
+ */
+typedef struct PhysicsSnapshot
+{
+    size_t size;
+    size_t capacity;
+    EC_RigidBody **bodies;
+    V3 *positions;
+    Quaternion *rotations;
+} PhysicsSnapshot;
+
 // -------------------------
 // Raycasting
 // -------------------------
@@ -52,32 +128,94 @@ typedef struct Ray{
 #define PHYSICS_GRAVITY_EARTH -9.81f
 #define PHYSICS_DEFAULT_LINEAR_DAMPING 0.99f
 #define PHYSICS_DEFAULT_ANGULAR_DAMPING 0.95f
-
-typedef struct Proxy
-{
-    uint32_t id;
-    AABB aabb;
-    Entity *entity;
-    // Colision Mask?
-    bool isStatic;
-} Proxy;
+#define PHYSICS_OVERLAP_CELL_SIZE 4.0f
+#define PHYSICS_OVERLAP_BUCKETS 4096
+// Rigidbodies per task in the stages spread over the task pool
+#define PHYSICS_PARALLEL_CHUNK 64
 
 typedef struct PhysicsManager
 {
-    size_t rigidbodies_size;
-    EC_RigidBody **rigidbodies;
-    Proxy *proxies;
+    RigidBodyStore *bodies;
+    ContactCache *contacts;
+    // Triggers, kept out of the solver and only checked for overlaps
+    size_t triggers_size;
+    size_t triggers_capacity;
+    /// @brief RigidBodyStore handles of the bodies with a trigger collider
+    uint32_t *triggers;
+    ContactCache *triggerContacts;
+    // Collision events of the current step, dispatched at its end
+    size_t events_size;
+    size_t events_capacity;
+    CollisionEvent *events;
+    // Gameplay writes, applied when the next step starts
+    size_t commands_size;
+    size_t commands_capacity;
+    PhysicsCommand *commands;
+    // Poses of the last two steps, snapshots[currentSnapshot] is the newest
+    PhysicsSnapshot snapshots[2];
+    uint8_t currentSnapshot;
+    /// @brief Transform poses replaced by PhysicsManager_Interpolate, NULL bodies were left alone
+    PhysicsSnapshot savedPoses;
+    float interpolationAlpha;
+    bool interpolated;
+    SweepAndPrune *broadphase;
+    SceneBVH *raycastTree;
+    SpatialHash *overlapGrid;
 
     // Global physics settings
     V3 gravity;
     float timeStep;
+
+    // Physics thread, runs the solver stages between PhysicsManager_BeginStep and PhysicsManager_EndStep
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    /// @brief Signaled when a step is queued or the thread is stopping
+    pthread_cond_t stepQueued;
+    /// @brief Signaled when the thread finished a step
+    pthread_cond_t stepDone;
+    /// @brief false when the thread could not be started, steps are then solved inline
+    bool threaded;
+    bool stopping;
+    /// @brief Set by BeginStep, cleared by the thread once the step is solved. Guarded by mutex.
+    bool stepPending;
+    /// @brief Set by BeginStep, cleared by EndStep. Main thread only.
+    bool stepInFlight;
 } PhysicsManager;
 
 // -------------------------
 // Update Loop
 // -------------------------
 
+/**
+ * @brief Run a whole step and wait for it, same as PhysicsManager_BeginStep followed by PhysicsManager_EndStep
+ */
 void PhysicsManager_FixedUpdate(PhysicsManager *physicsManager);
+/**
+ * @brief Apply the queued commands, read the transforms and hand the step to the physics thread.
+ * Until PhysicsManager_EndStep, the caller may render and run gameplay code but should not expect
+ * rigidbody poses to change.
+ */
+void PhysicsManager_BeginStep(PhysicsManager *physicsManager);
+/**
+ * @brief Wait for the step started by PhysicsManager_BeginStep, write its poses to the transforms,
+ * publish them as the newest snapshot and dispatch the collision events. Does nothing if no step is running.
+ */
+void PhysicsManager_EndStep(PhysicsManager *physicsManager);
+
+// -------------------------
+// Interpolation
+// -------------------------
+
+/**
+ * @brief Move every body the last steps moved to alpha between its two newest snapshots, for rendering.
+ * Rendering then lags one step behind the simulation, but moves smoothly when frames and steps do not line up.
+ * @param alpha Fraction of a step elapsed since the newest snapshot, clamped to [0, 1]
+ */
+void PhysicsManager_Interpolate(PhysicsManager *physicsManager, float alpha);
+/**
+ * @brief Put back the poses PhysicsManager_Interpolate replaced, except where gameplay code moved the transform since
+ */
+void PhysicsManager_EndInterpolation(PhysicsManager *physicsManager);
 
 // -------------------------
 // Manager Management
@@ -89,10 +227,19 @@ void PhysicsManager_Select(PhysicsManager *physicsManager);
 // Physics Operations
 // -------------------------
 
+// Writes are queued and applied when the next step starts, reads wait for the running step
 void PhysicsManager_AddForce(EC_RigidBody *rigidbody, V3 force);
 void PhysicsManager_AddTorque(EC_RigidBody *rigidbody, V3 torque);
 void PhysicsManager_SetVelocity(EC_RigidBody *rigidbody, V3 velocity);
 void PhysicsManager_SetAngularVelocity(EC_RigidBody *rigidbody, V3 angularVelocity);
+/**
+ * @brief Kinematic bodies are moved by gameplay code through their transform, e.g. by a CharacterController.
+ * The solver skips them: they are not integrated, not paired with static bodies and push dynamic bodies without
+ * being pushed back.
+ */
+void PhysicsManager_SetKinematic(EC_RigidBody *rigidbody, bool isKinematic);
+V3 PhysicsManager_GetVelocity(EC_RigidBody *rigidbody);
+V3 PhysicsManager_GetAngularVelocity(EC_RigidBody *rigidbody);
 
 // -------------------------
 // Physics Settings
@@ -107,7 +254,10 @@ float PhysicsManager_GetTimeStep();
 // Rigidbody Management
 // -------------------------
 
-void PhysicsManager_RegisterRigidBody(EC_RigidBody *ec_rigidbody);
+/**
+ * @brief Add the body's state to the manager's store and its bounds to the broadphase
+ */
+void PhysicsManager_RegisterRigidBody(EC_RigidBody *ec_rigidbody, float mass, bool useGravity, RigidBodyConstraints constraints);
 void PhysicsManager_RemoveRigidBody(EC_RigidBody *ec_rigidbody);
 
 // -------------------------
@@ -125,6 +275,18 @@ void PhysicsManager_RemoveRigidBody(EC_RigidBody *ec_rigidbody);
  */
 bool PhysicsManager_Raycast(Ray *ray, float maxDistance, RaycastHit *outHit, uint32_t layerMask);
 
+/**
+ * @brief Cast many rays at once. Gives the same hits as calling PhysicsManager_Raycast on each ray,
+ * but shares the scene traversal between rays travelling in similar directions
+ * @param rays Rays to cast, directions will be normalized
+ * @param n Number of rays
+ * @param maxDistance Maximum distance to check, for every ray
+ * @param outHits Array of n RaycastHit structs, filled in ray order
+ * @param layerMask Bitmask of layers to include in the raycast
+ * @return Number of rays that hit something
+ */
+size_t PhysicsManager_RaycastBatch(const Ray *rays, size_t n, float maxDistance, RaycastHit *outHits, uint32_t layerMask);
+
 /**
  * @brief Initialize all fields of a RaycastHit to default values
  * @param hit Pointer to the RaycastHit to initialize
@@ -137,9 +299,10 @@ void RaycastHit_Init(RaycastHit *hit);
  * @param halfExtents Half-size of the box on each axis
  * @param outColliders Array to store found colliders
  * @param maxColliders Maximum number of colliders to return
+ * @param layerMask Bitmask of the layers (1 << layer) to include
  * @return Number of colliders found
  */
-int PhysicsManager_BoxCast(V3 center, V3 halfExtents, EC_Collider **outColliders, int maxColliders);
+int PhysicsManager_BoxCast(V3 center, V3 halfExtents, EC_Collider **outColliders, int maxColliders, uint32_t layerMask);
 
 /**
  * @brief Find all colliders overlapping a sphere shape
@@ -147,9 +310,10 @@ int PhysicsManager_BoxCast(V3 center, V3 halfExtents, EC_Collider **outColliders
  * @param radius Radius of the sphere
  * @param outColliders Array to store found colliders
  * @param maxColliders Maximum number of colliders to return
+ * @param layerMask Bitmask of the layers (1 << layer) to include
  * @return Number of colliders found
  */
-int PhysicsManager_SphereCast(V3 center, float radius, EC_Collider **outColliders, int maxColliders);
+int PhysicsManager_SphereCast(V3 center, float radius, EC_Collider **outColliders, int maxColliders, uint32_t layerMask);
 
 // -------------------------
 // Creation & Freeing
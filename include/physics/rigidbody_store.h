@@ -0,0 +1,110 @@
+#ifndef RIGIDBODY_STORE_H
+#define RIGIDBODY_STORE_H
+
+// Math
+#include "utilities/math/v3.h"
+#include "entity/transform.h"
+// Bounds
+#include "physics/aabb.h"
+// C
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct EC_RigidBody EC_RigidBody;
+
+// -------------------------
+// Types
+// -------------------------
+
+#define RIGIDBODY_HANDLE_NONE UINT32_MAX
+
+// Flags
+#define RIGIDBODY_GRAVITY (1u << 0)
+#define RIGIDBODY_KINEMATIC (1u << 1)
+#define RIGIDBODY_STATIC (1u << 2)
+#define RIGIDBODY_SLEEPING (1u << 3)
+/// @brief The position changed this step and has to be written back to the transform
+#define RIGIDBODY_MOVED (1u << 4)
+/// @brief The rotation changed this step and has to be written back to the transform
+#define RIGIDBODY_ROTATED (1u << 5)
+/// @brief The broadphase already treats the sleeping body as static
+#define RIGIDBODY_PROXY_ASLEEP (1u << 6)
+
+typedef struct RigidBodyConstraints
+{
+    bool freezePositionX;
+    bool freezePositionY;
+    bool freezePositionZ;
+    bool freezeRotationX;
+    bool freezeRotationY;
+    bool freezeRotationZ;
+} RigidBodyConstraints;
+
+/**
+ * @brief Simulation state of every rigidbody, one dense array per field. Index i of every array belongs to the same
+ * body and there are no holes: removing a body moves the last one into its slot.
+ * Components refer to their slot through a handle, which stays stable until the body is removed.
+ */
+typedef struct RigidBodyStore
+{
+    size_t size;
+    size_t capacity;
+    // Owners
+    EC_RigidBody **bodies;
+    uint32_t *handles;
+    // Pose, relative to the parent transform like Transform::l_pos and Transform::l_rot
+    V3 *positions;
+    Quaternion *rotations;
+    // Motion
+    V3 *velocities;
+    V3 *angularVelocities;
+    V3 *forces;
+    V3 *torques;
+    /// @brief 1 / mass, 0 for massless bodies
+    float *invMasses;
+    float *linearDampings;
+    float *angularDampings;
+    float *sleepTimers;
+    /// @brief Island the body fell asleep with, its members wake up together
+    uint32_t *sleepIslands;
+    RigidBodyConstraints *constraints;
+    uint8_t *flags;
+    // Broadphase
+    AABB *worldAABBs;
+    uint8_t *layers;
+    // Handles, slots[handle] is the body's index
+    size_t slots_size;
+    size_t slots_capacity;
+    uint32_t *slots;
+    size_t freeHandles_size;
+    uint32_t *freeHandles;
+} RigidBodyStore;
+
+// -------------------------
+// Bodies
+// -------------------------
+
+/**
+ * @brief Append a body at rest with identity rotation and no flags
+ * @return Handle of the body, stable until RigidBodyStore_Remove is called on it
+ */
+uint32_t RigidBodyStore_Add(RigidBodyStore *store, EC_RigidBody *body);
+/**
+ * @brief Remove a body, the last body moves into its index
+ */
+void RigidBodyStore_Remove(RigidBodyStore *store, uint32_t handle);
+
+inline static uint32_t RigidBodyStore_Index(const RigidBodyStore *store, uint32_t handle)
+{
+    return store->slots[handle];
+}
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+RigidBodyStore *RigidBodyStore_Create();
+void RigidBodyStore_Free(RigidBodyStore *store);
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef SCENE_BVH_H
+#define SCENE_BVH_H
+
+// Bounds
+#include "physics/aabb.h"
+// C
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct EC_Collider EC_Collider;
+
+// -------------------------
+// Types
+// -------------------------
+
+#define SCENE_BVH_NONE UINT32_MAX
+/// @brief Rebuild once refitting has grown the tree's surface area cost past this factor of its build cost
+#define SCENE_BVH_REBUILD_COST_FACTOR 2.0f
+
+/**
+ * @brief A collider tracked by the scene BVH. Items are referenced by their index, which
+ * stays stable until the item is removed.
+ */
+typedef struct SceneBVHItem
+{
+    EC_Collider *collider;
+    V3 min;
+    V3 max;
+    /// @brief Layers this item can be hit by, 0 if it is not raycastable
+    uint32_t layerMask;
+    bool inUse;
+} SceneBVHItem;
+
+/**
+ * @brief Node of the tree. Nodes are stored in depth-first order, so children always come after their parent.
+ */
+typedef struct SceneBVHNode
+{
+    V3 min;
+    V3 max;
+    /// @brief OR of the layer masks of every item below this node
+    uint32_t layerMask;
+    uint32_t left;
+    uint32_t right;
+    /// @brief Item index for leaves, SCENE_BVH_NONE for internal nodes
+    uint32_t item;
+} SceneBVHNode;
+
+typedef struct SceneBVH
+{
+    // Items
+    size_t items_size;
+    size_t items_capacity;
+    SceneBVHItem *items;
+    size_t freeItems_size;
+    uint32_t *freeItems;
+    // Tree
+    size_t nodes_size;
+    size_t nodes_capacity;
+    SceneBVHNode *nodes;
+    /// @brief Set when items were added or removed, the next update rebuilds the tree
+    bool needsRebuild;
+    /// @brief Surface area cost of the tree right after it was built
+    float buildCost;
+    // Build scratch
+    uint32_t *buildItems;
+    // Batch scratch
+    size_t rayOrder_capacity;
+    uint32_t *rayOrder;
+} SceneBVH;
+
+/**
+ * @brief Called for every leaf a ray enters. Single rays visit leaves nearest first, batches do not.
+ * @param ray Index of the ray in the batch, 0 for single rays
+ * @param item Index of the item, lets callbacks break ties between equally distant hits
+ * @param tEnter Distance at which the ray enters the item's bounds (may be negative if the origin is inside)
+ * @param tExit Distance at which the ray leaves the item's bounds
+ * @param maxDistance Closest hit found so far
+ * @return The new closest hit distance, or maxDistance if nothing closer was hit
+ */
+typedef float (*SceneBVHRaycastCallback)(void *context, uint32_t ray, uint32_t item, EC_Collider *collider,
+                                        float tEnter, float tExit, float maxDistance);
+
+// -------------------------
+// Items
+// -------------------------
+
+uint32_t SceneBVH_Insert(SceneBVH *bvh, EC_Collider *collider, AABB bounds, uint32_t layerMask);
+void SceneBVH_Remove(SceneBVH *bvh, uint32_t item);
+/**
+ * @brief Refresh the bounds and layer mask of an item. Takes effect on the next SceneBVH_Update
+ */
+void SceneBVH_UpdateItem(SceneBVH *bvh, uint32_t item, AABB bounds, uint32_t layerMask);
+
+// -------------------------
+// Update & Queries
+// -------------------------
+
+/**
+ * @brief Refit the tree to the items' current bounds, rebuilding it when items were added or removed
+ * or when refitting degraded its quality too much
+ */
+void SceneBVH_Update(SceneBVH *bvh);
+
+/**
+ * @brief Traverse the tree front-to-back, stopping as soon as no node can beat the closest hit
+ * @param invDirection Component-wise inverse of the normalized ray direction
+ * @param layerMask Only items whose layer mask intersects it are reported
+ * @return Distance of the closest hit reported by the callback, or maxDistance
+ */
+float SceneBVH_Raycast(SceneBVH *bvh, V3 origin, V3 invDirection, float maxDistance, uint32_t layerMask,
+                       SceneBVHRaycastCallback callback, void *context);
+
+/**
+ * @brief Traverse the tree for many rays at once. Rays are binned by direction octant and walk the tree
+ * in packets, so each node is fetched once per packet instead of once per ray.
+ * @param maxDistances Per ray, updated with the distance returned by the callback
+ */
+void SceneBVH_RaycastBatch(SceneBVH *bvh, const V3 *origins, const V3 *invDirections, float *maxDistances, size_t rays_size,
+                           uint32_t layerMask, SceneBVHRaycastCallback callback, void *context);
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+SceneBVH *SceneBVH_Create();
+void SceneBVH_Free(SceneBVH *bvh);
+
+#endif
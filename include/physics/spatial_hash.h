@@ -0,0 +1,112 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+// Bounds
+#include "physics/aabb.h"
+// C
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct EC_Collider EC_Collider;
+
+// -------------------------
+// Types
+// -------------------------
+
+#define SPATIAL_HASH_NONE UINT32_MAX
+/// @brief Items spanning more cells than this are kept in a separate list instead of being hashed
+#define SPATIAL_HASH_MAX_ITEM_CELLS 64
+
+typedef struct SpatialHashEntry
+{
+    int32_t x, y, z;
+    uint32_t layer;
+    uint32_t item;
+} SpatialHashEntry;
+
+typedef struct SpatialHashBucket
+{
+    uint32_t entries_size;
+    uint32_t entries_capacity;
+    SpatialHashEntry *entries;
+} SpatialHashBucket;
+
+/**
+ * @brief A collider tracked by the hash. Items are referenced by their index, which
+ * stays stable until the item is removed.
+ */
+typedef struct SpatialHashItem
+{
+    EC_Collider *collider;
+    AABB bounds;
+    uint32_t layer;
+    /// @brief Inclusive range of cells currently holding the item
+    int32_t cellMin[3];
+    int32_t cellMax[3];
+    /// @brief Too large to hash, lives in the large item list
+    bool isLarge;
+    bool inUse;
+    /// @brief Last query that reported this item, avoids duplicates from items spanning several cells
+    uint32_t queryStamp;
+} SpatialHashItem;
+
+typedef struct SpatialHash
+{
+    float cellSize;
+    float invCellSize;
+    // Buckets (count is a power of two)
+    size_t buckets_size;
+    SpatialHashBucket *buckets;
+    // Items
+    size_t items_size;
+    size_t items_capacity;
+    SpatialHashItem *items;
+    size_t freeItems_size;
+    uint32_t *freeItems;
+    // Items too large to hash
+    size_t largeItems_size;
+    size_t largeItems_capacity;
+    uint32_t *largeItems;
+    uint32_t queryStamp;
+} SpatialHash;
+
+/**
+ * @brief Called once per item whose cells overlap the query
+ * @return false to stop the query
+ */
+typedef bool (*SpatialHashQueryCallback)(void *context, EC_Collider *collider, AABB bounds);
+
+// -------------------------
+// Items
+// -------------------------
+
+uint32_t SpatialHash_Insert(SpatialHash *hash, EC_Collider *collider, AABB bounds, uint32_t layer);
+void SpatialHash_Remove(SpatialHash *hash, uint32_t item);
+/**
+ * @brief Refresh the bounds and layer of an item. Only touches the buckets when its cell range or layer changed
+ */
+void SpatialHash_Update(SpatialHash *hash, uint32_t item, AABB bounds, uint32_t layer);
+
+// -------------------------
+// Queries
+// -------------------------
+
+/**
+ * @brief Report every item on a layer in layerMask whose cells overlap the bounds.
+ * @note Candidates only, callers run their own exact test against the reported bounds
+ */
+void SpatialHash_Query(SpatialHash *hash, AABB bounds, uint32_t layerMask, SpatialHashQueryCallback callback, void *context);
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+/**
+ * @param cellSize Edge length of a cell, should be around the size of a typical collider
+ * @param bucketCount Rounded up to a power of two
+ */
+SpatialHash *SpatialHash_Create(float cellSize, size_t bucketCount);
+void SpatialHash_Free(SpatialHash *hash);
+
+#endif
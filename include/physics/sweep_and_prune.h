@@ -0,0 +1,143 @@
+#ifndef SWEEP_AND_PRUNE_H
+#define SWEEP_AND_PRUNE_H
+
+// Bounds
+#include "physics/aabb.h"
+// C
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct EC_RigidBody EC_RigidBody;
+
+// -------------------------
+// Types
+// -------------------------
+
+#define SAP_PROXY_NONE UINT32_MAX
+
+/**
+ * @brief How a proxy moves, decides which other proxies it is paired with
+ */
+typedef enum SAPMotion
+{
+    /// @brief Moved by the solver, paired with every other proxy
+    SAP_MOTION_DYNAMIC,
+    /// @brief Moves on its own and is not pushed back, paired with dynamic and sleeping proxies
+    SAP_MOTION_KINEMATIC,
+    /// @brief A dynamic body at rest, paired with what can wake it: dynamic and kinematic proxies
+    SAP_MOTION_SLEEPING,
+    /// @brief Never moves, paired with dynamic proxies only
+    SAP_MOTION_STATIC,
+} SAPMotion;
+
+/**
+ * @brief A box registered in the broadphase. Proxies are referenced by their index, which
+ * stays stable until the proxy is removed.
+ */
+typedef struct SAPProxy
+{
+    EC_RigidBody *rigidbody;
+    AABB aabb;
+    /// @brief (1 << layer) of the owning entity
+    uint32_t layerBit;
+    /// @brief Layers this proxy is allowed to collide with
+    uint32_t collisionMask;
+    SAPMotion motion;
+    bool inUse;
+} SAPProxy;
+
+/**
+ * @brief One end of a proxy's interval on an axis.
+ * @note data packs the proxy index and a min/max flag: (proxy << 1) | isMax
+ */
+typedef struct SAPEndpoint
+{
+    float value;
+    uint32_t data;
+} SAPEndpoint;
+
+typedef struct SAPPair
+{
+    uint32_t proxyA;
+    uint32_t proxyB;
+} SAPPair;
+
+typedef struct SweepAndPrune
+{
+    // Proxies
+    size_t proxies_size;
+    size_t proxies_capacity;
+    SAPProxy *proxies;
+    size_t freeProxies_size;
+    uint32_t *freeProxies;
+    // Sorted endpoints, one list per axis (2 per live proxy)
+    size_t endpoints_size;
+    size_t endpoints_capacity;
+    SAPEndpoint *endpoints[3];
+    /// @brief Axis with the largest spread, used to sweep for pairs
+    int sweepAxis;
+    // Sweep scratch
+    size_t active_size;
+    uint32_t *active;
+    uint32_t *activeSlot;
+    // Output
+    size_t pairs_size;
+    size_t pairs_capacity;
+    SAPPair *pairs;
+} SweepAndPrune;
+
+// -------------------------
+// Proxies
+// -------------------------
+
+/**
+ * @brief Register a box with the broadphase
+ * @return Index of the new proxy, stable until SweepAndPrune_RemoveProxy is called on it
+ */
+uint32_t SweepAndPrune_AddProxy(SweepAndPrune *sap, EC_RigidBody *rigidbody, AABB aabb, uint32_t layerBit, uint32_t collisionMask, SAPMotion motion);
+void SweepAndPrune_RemoveProxy(SweepAndPrune *sap, uint32_t proxy);
+/**
+ * @brief Refresh the cached bounds and filtering data of a proxy. Takes effect on the next SweepAndPrune_Update
+ */
+void SweepAndPrune_UpdateProxy(SweepAndPrune *sap, uint32_t proxy, AABB aabb, uint32_t layerBit, uint32_t collisionMask, SAPMotion motion);
+
+// -------------------------
+// Update & Queries
+// -------------------------
+
+/**
+ * @brief Whether proxies moving this way are ever paired, whatever their bounds and layers
+ */
+inline static bool SweepAndPrune_MotionsPair(SAPMotion a, SAPMotion b)
+{
+    static const uint8_t pairsWith[] = {
+        [SAP_MOTION_DYNAMIC] = (1u << SAP_MOTION_DYNAMIC) | (1u << SAP_MOTION_KINEMATIC) | (1u << SAP_MOTION_SLEEPING) | (1u << SAP_MOTION_STATIC),
+        [SAP_MOTION_KINEMATIC] = (1u << SAP_MOTION_DYNAMIC) | (1u << SAP_MOTION_SLEEPING),
+        [SAP_MOTION_SLEEPING] = (1u << SAP_MOTION_DYNAMIC) | (1u << SAP_MOTION_KINEMATIC),
+        [SAP_MOTION_STATIC] = (1u << SAP_MOTION_DYNAMIC),
+    };
+    return pairsWith[a] & (1u << b);
+}
+
+/**
+ * @brief Re-sort the endpoint lists from the proxies' current bounds.
+ * @note Uses insertion sort, which is close to O(n) since bodies barely move between fixed steps
+ */
+void SweepAndPrune_Update(SweepAndPrune *sap);
+
+/**
+ * @brief Sweep the sorted endpoints and collect every overlapping pair into sap->pairs.
+ * @note Pairs whose motions do not pair (see SweepAndPrune_MotionsPair) or whose layers do not collide are never emitted
+ * @return Number of pairs found
+ */
+size_t SweepAndPrune_FindPairs(SweepAndPrune *sap);
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+SweepAndPrune *SweepAndPrune_Create();
+void SweepAndPrune_Free(SweepAndPrune *sap);
+
+#endif
@@ -50,6 +50,8 @@ typedef struct
     /// @brief Reference count for shared meshes. Do not modify this directly, use Mesh_AddRef and Mesh_Release.
     bool isRegistered;
     int refCount;
+    /// @brief Built on first use by Mesh_GetBVH and shared by every collider using this mesh. Freed with the mesh.
+    MeshBVH *bvh;
 } Mesh;
 
 // ------------------------- 
@@ -82,10 +84,23 @@ Mesh *Mesh_CreateCapsuleWireframe(float radius, float height, V3 pivot, uint32_t
 void Mesh_MarkReferenced(Mesh *mesh);
 void Mesh_MarkUnreferenced(Mesh *mesh);
 
+// ------------------------- 
+// Physics 
+// -------------------------
+
+/**
+ * @brief Get the mesh's BVH, building it on the first call
+ * @return The shared BVH, or NULL if the mesh has no triangles
+ */
+MeshBVH *Mesh_GetBVH(Mesh *mesh);
+
 // ------------------------- 
 // Utilities 
 // -------------------------
 
+/**
+ * @brief Upload vertices to the GPU. When data points into mesh->vertices, the mesh's BVH is refit too.
+ */
 void Mesh_UpdateVertexBuffer(Mesh *mesh, size_t offset, size_t count, const Vertex *data);
 void Mesh_UpdateIndexBuffer(Mesh *mesh, size_t offset, size_t count, const uint32_t *data);
 void Vertex_MinMax(size_t vertices_size, Vertex* vertices, V3 *min, V3 *max);
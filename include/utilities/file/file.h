@@ -3,8 +3,23 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
 
 char *File_LoadStr(const char *filename);
 unsigned char *File_LoadBinary(const char *filename);
 
+/**
+ * @brief Map a whole file into memory without reading it. The mapping is copy-on-write:
+ * writes to it stay private to the process and never reach the file.
+ * @param outSize Size of the file in bytes
+ * @return NULL if the file does not exist or is empty. Release with File_Unmap.
+ */
+void *File_Map(const char *filename, size_t *outSize);
+void File_Unmap(void *data, size_t size);
+
+/**
+ * @brief Create a directory, succeeds if it already exists. Parent directories are not created.
+ */
+bool File_CreateDirectory(const char *path);
+
 #endif
\ No newline at end of file
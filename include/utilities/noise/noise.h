@@ -14,6 +14,7 @@
 #include <glad/glad.h>
 
 typedef struct Noise Noise;
+typedef struct Heightfield Heightfield;
 
 typedef struct {
     void (*function)(Noise *noise, int argCount, void** args);
@@ -65,5 +66,9 @@ void Noise_AddModifier(Noise *noise, NoiseModifier modifier);
 // Utilities 
 // -------------------------
 
-float Noise_GetMeshHeightAt(Noise *noise, V3 positionIslandSpace, V3 meshScale, V3 pivot);
+/**
+ * @brief Heightfield laid out exactly like the mesh Noise_CreateMesh builds with the same scale and pivot.
+ * @note It reads noise->map directly, refresh it with Heightfield_Update when the map is recreated.
+ */
+Heightfield *Noise_CreateHeightfield(Noise *noise, V3 meshScale, V3 pivot);
 #endif
\ No newline at end of file
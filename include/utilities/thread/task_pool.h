@@ -0,0 +1,94 @@
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+// C
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+// -------------------------
+// Types
+// -------------------------
+
+typedef void (*TaskFunction)(void *data);
+/// @brief Processes the items [begin, end) of a TaskPool_ParallelFor
+typedef void (*TaskRangeFunction)(void *data, size_t begin, size_t end);
+
+typedef struct Task
+{
+    TaskFunction function;
+    void *data;
+    struct TaskGroup *group;
+} Task;
+
+/**
+ * @brief Tracks a batch of submitted tasks so the submitter can wait for all of them. Zero-initialize before use.
+ */
+typedef struct TaskGroup
+{
+    uint32_t pending;
+} TaskGroup;
+
+typedef struct TaskPool
+{
+    pthread_mutex_t mutex;
+    /// @brief Signaled when a task is queued or the pool is stopping
+    pthread_cond_t taskQueued;
+    /// @brief Signaled when a group's last task finished
+    pthread_cond_t groupDone;
+    // Queue (LIFO, the newest tasks are the smallest in recursive workloads)
+    size_t tasks_size;
+    size_t tasks_capacity;
+    Task *tasks;
+    // Workers
+    uint32_t workers_size;
+    pthread_t *workers;
+    bool stopping;
+} TaskPool;
+
+// -------------------------
+// Creation and Freeing
+// -------------------------
+
+/**
+ * @brief Create a pool and select it as the current one
+ * @param workers_size Worker threads, the thread waiting on a group also runs tasks. 0 runs everything inline.
+ */
+TaskPool *TaskPool_Create(uint32_t workers_size);
+/**
+ * @brief Finish the queued tasks, then join the workers
+ */
+void TaskPool_Free(TaskPool *pool);
+
+// -------------------------
+// Functions
+// -------------------------
+
+void TaskPool_Select(TaskPool *pool);
+/**
+ * @return The selected pool, NULL if there is none
+ */
+TaskPool *TaskPool_Get();
+/**
+ * @brief Number of hardware threads, at least 1
+ */
+uint32_t TaskPool_HardwareThreads();
+
+/**
+ * @brief Queue a task. Runs it right away when pool is NULL or has no workers.
+ */
+void TaskPool_Submit(TaskPool *pool, TaskGroup *group, TaskFunction function, void *data);
+/**
+ * @brief Block until every task of the group finished, running queued tasks meanwhile.
+ * Tasks may submit and wait on their own groups.
+ */
+void TaskPool_Wait(TaskPool *pool, TaskGroup *group);
+/**
+ * @brief Split [0, count) into chunks of chunk_size items and spread them over the pool, returning once all ran.
+ * Chunks are claimed dynamically, so function must not depend on which thread or in which order they run.
+ * Runs inline as a single range when pool is NULL, has no workers or count fits in one chunk.
+ */
+void TaskPool_ParallelFor(TaskPool *pool, size_t count, size_t chunk_size, TaskRangeFunction function, void *data);
+
+#endif
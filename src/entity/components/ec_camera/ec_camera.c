@@ -218,10 +218,10 @@ static void Camera_RenderDebugColliders(EC_Camera *ec_camera)
     glDisable(GL_CULL_FACE);
 
     // Render all colliders
-    for (int i = 0; i < physicsManager->rigidbodies_size; i++)
+    for (size_t i = 0; i < physicsManager->bodies->size; i++)
     {
-        EC_RigidBody *rigidbody = physicsManager->rigidbodies[i];
-        if (!rigidbody || !rigidbody->ec_collider)
+        EC_RigidBody *rigidbody = physicsManager->bodies->bodies[i];
+        if (!rigidbody->ec_collider)
             continue;
 
         EC_Collider *collider = rigidbody->ec_collider;
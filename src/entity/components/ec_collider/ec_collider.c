@@ -6,6 +6,8 @@
 #include "physics/aabb.h"
 // Mesh
 #include "rendering/mesh/mesh.h"
+// Heightfield
+#include "physics/heightfield.h"
 // Math
 #include "utilities/math/v3.h"
 // C
@@ -26,16 +28,57 @@ void EC_Collider_Free(Component *component)
 {
     EC_Collider *ec_collider = component->self;
 #ifdef DEBUG_COLLIDERS
-    Mesh_MarkUnreferenced(ec_collider->debugMesh);
+    if (ec_collider->debugMesh)
+        Mesh_MarkUnreferenced(ec_collider->debugMesh);
 #endif
-    // Free collision tracking arrays
-    if (ec_collider->currentCollisions)
+    // The mesh (and its BVH) stays alive as long as a collider uses it
+    if (ec_collider->type == EC_COLLIDER_MESH)
     {
-        free(ec_collider->currentCollisions);
+        Mesh_MarkUnreferenced(ec_collider->data.mesh.mesh);
+    }
+    else if (ec_collider->type == EC_COLLIDER_HEIGHTFIELD)
+    {
+        Heightfield_Free(ec_collider->data.heightfield.heightfield);
     }
     free(ec_collider);
 }
 
+/// @brief Rotation-aware world AABB of a static collider whose localAABB already includes the offset
+static void ComputeStaticWorldAABB(EC_Collider *ec_collider)
+{
+    Transform *transform = ec_collider->transform;
+    V3 w_pos = T_WPos(transform);
+    V3 w_scale = T_WSca(transform);
+    V3 right = T_Right(transform);
+    V3 up = T_Up(transform);
+    V3 forward = T_Forward(transform);
+
+    // Compute local center and half-size (localAABB already includes offset)
+    V3 localCenter = V3_SCALE(V3_ADD(ec_collider->localAABB.min, ec_collider->localAABB.max), 0.5f);
+    V3 localHalf = V3_SCALE(V3_SUB(ec_collider->localAABB.max, ec_collider->localAABB.min), 0.5f);
+
+    // Apply entity scale
+    localCenter = V3_MUL(localCenter, w_scale);
+    localHalf = V3_ABS(V3_MUL(localHalf, w_scale)); // ensure positive
+
+    // Compute world-space half-extents (rotation-aware)
+    V3 absRight = {fabsf(right.x), fabsf(right.y), fabsf(right.z)};
+    V3 absUp = {fabsf(up.x), fabsf(up.y), fabsf(up.z)};
+    V3 absForward = {fabsf(forward.x), fabsf(forward.y), fabsf(forward.z)};
+    V3 halfWorld = {
+        localHalf.x * absRight.x + localHalf.y * absUp.x + localHalf.z * absForward.x,
+        localHalf.x * absRight.y + localHalf.y * absUp.y + localHalf.z * absForward.y,
+        localHalf.x * absRight.z + localHalf.y * absUp.z + localHalf.z * absForward.z,
+    };
+
+    // Final world center (localCenter already includes offset, just add world position)
+    V3 worldCenter = V3_ADD(w_pos, localCenter);
+
+    // Construct world-space AABB
+    ec_collider->worldAABB.min = V3_SUB(worldCenter, halfWorld);
+    ec_collider->worldAABB.max = V3_ADD(worldCenter, halfWorld);
+}
+
 EC_Collider *EC_Collider_CreateBox(EC_Collider *ec_collider, V3 scale)
 {
     ec_collider->data.box.scale = scale;
@@ -48,40 +91,8 @@ EC_Collider *EC_Collider_CreateBox(EC_Collider *ec_collider, V3 scale)
     ec_collider->localAABB.max.y = halfBox.y + ec_collider->offset.y;
     ec_collider->localAABB.max.z = halfBox.z + ec_collider->offset.z;
     // ============ Compute World AABB (If Static) ============ //
-    Transform *transform = ec_collider->transform;
     if (*ec_collider->isStatic)
-    {
-        V3 w_pos = T_WPos(transform);
-        V3 w_scale = T_WSca(transform);
-        V3 right = T_Right(transform);
-        V3 up = T_Up(transform);
-        V3 forward = T_Forward(transform);
-
-        // Compute local center and half-size (localAABB already includes offset)
-        V3 localCenter = V3_SCALE(V3_ADD(ec_collider->localAABB.min, ec_collider->localAABB.max), 0.5f);
-        V3 localHalf = V3_SCALE(V3_SUB(ec_collider->localAABB.max, ec_collider->localAABB.min), 0.5f);
-
-        // Apply entity scale
-        localCenter = V3_MUL(localCenter, w_scale);
-        localHalf = V3_ABS(V3_MUL(localHalf, w_scale)); // ensure positive
-
-        // Compute world-space half-extents (rotation-aware)
-        V3 absRight = {fabsf(right.x), fabsf(right.y), fabsf(right.z)};
-        V3 absUp = {fabsf(up.x), fabsf(up.y), fabsf(up.z)};
-        V3 absForward = {fabsf(forward.x), fabsf(forward.y), fabsf(forward.z)};
-        V3 halfWorld = {
-            localHalf.x * absRight.x + localHalf.y * absUp.x + localHalf.z * absForward.x,
-            localHalf.x * absRight.y + localHalf.y * absUp.y + localHalf.z * absForward.y,
-            localHalf.x * absRight.z + localHalf.y * absUp.z + localHalf.z * absForward.z,
-        };
-
-        // Final world center (localCenter already includes offset, just add world position)
-        V3 worldCenter = V3_ADD(w_pos, localCenter);
-
-        // Construct world-space AABB
-        ec_collider->worldAABB.min = V3_SUB(worldCenter, halfWorld);
-        ec_collider->worldAABB.max = V3_ADD(worldCenter, halfWorld);
-    }
+        ComputeStaticWorldAABB(ec_collider);
 
 #ifdef DEBUG_COLLIDERS
     // ============ DEBUG:: Create debugging mesh ============ //
@@ -198,6 +209,10 @@ static EC_Collider *EC_Collider_CreateMesh(EC_Collider *ec_collider, Mesh *mesh)
     AABB localAABB;
     Vertex_MinMax(mesh->vertices_size, mesh->vertices, &localAABB.min, &localAABB.max);
     ec_collider->localAABB = localAABB;
+    // ============ Shared BVH ============ //
+    Mesh_MarkReferenced(mesh);
+    ec_collider->data.mesh.mesh = mesh;
+    ec_collider->data.mesh.bvh = Mesh_GetBVH(mesh);
     // ============ Compute World AABB (If Static) ============ //
     if (*ec_collider->isStatic)
     {
@@ -250,6 +265,24 @@ static EC_Collider *EC_Collider_CreateMesh(EC_Collider *ec_collider, Mesh *mesh)
     return ec_collider;
 }
 
+static EC_Collider *EC_Collider_CreateHeightfield(EC_Collider *ec_collider, Heightfield *heightfield)
+{
+    ec_collider->data.heightfield.heightfield = heightfield;
+    // ============ Pre-compute Local AABB ============ //
+    ec_collider->localAABB.min = V3_ADD(heightfield->bounds.min, ec_collider->offset);
+    ec_collider->localAABB.max = V3_ADD(heightfield->bounds.max, ec_collider->offset);
+    // ============ Compute World AABB (If Static) ============ //
+    if (*ec_collider->isStatic)
+        ComputeStaticWorldAABB(ec_collider);
+
+#ifdef DEBUG_COLLIDERS
+    // Terrain is already drawn by its renderer, a wireframe of every cell would only hide it
+    ec_collider->debugColor = 0xffffff00;
+    ec_collider->debugMesh = NULL;
+#endif
+    return ec_collider;
+}
+
 EC_Collider *EC_Collider_Create(Entity *entity, V3 offset, bool isTrigger, EC_Collider_T type, ColliderData data)
 {
     EC_Collider *ec_collider = malloc(sizeof(EC_Collider));
@@ -268,11 +301,6 @@ EC_Collider *EC_Collider_Create(Entity *entity, V3 offset, bool isTrigger, EC_Co
     ec_collider->OnCollisionStay = NULL;
     ec_collider->OnCollisionExit = NULL;
 
-    // Initialize collision tracking arrays
-    ec_collider->currentCollisions = NULL;
-    ec_collider->currentCollisions_size = 0;
-    ec_collider->currentCollisions_capacity = 0;
-
     switch (type)
     {
     case EC_COLLIDER_BOX:
@@ -287,6 +315,9 @@ EC_Collider *EC_Collider_Create(Entity *entity, V3 offset, bool isTrigger, EC_Co
     case EC_COLLIDER_MESH:
         EC_Collider_CreateMesh(ec_collider, data.mesh.mesh);
         break;
+    case EC_COLLIDER_HEIGHTFIELD:
+        EC_Collider_CreateHeightfield(ec_collider, data.heightfield.heightfield);
+        break;
     default:
         break;
     }
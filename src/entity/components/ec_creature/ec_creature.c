@@ -12,6 +12,8 @@
 #include "entity/components/ec_collider/ec_collider.h"
 // Rigidbody
 #include "entity/components/ec_rigidbody/ec_rigidbody.h"
+// Character Controller
+#include "physics/character_controller.h"
 
 // -------------------------
 // Entity Events
@@ -22,13 +24,15 @@ static void EC_Creature_FixedUpdate(Component *component)
     EC_Creature *ec_creature = component->self;
     CreatureController *controller = &ec_creature->controller;
     // ============ Movement ============ //
+    V3 moveDir = V3_ZERO;
     if (controller->input_move.x != 0 || controller->input_move.y != 0)
     {
         V3 forward = T_Forward(ec_creature->transform);
         V3 right = T_Right(ec_creature->transform);
-        V3 moveDir = V3_ADD(V3_SCALE(forward, controller->input_move.y * FixedDeltaTime * controller->movementSpeed.y),
-                            V3_SCALE(right, controller->input_move.x * FixedDeltaTime * controller->movementSpeed.x));
-        T_LPos_Add(ec_creature->transform, moveDir);
+        moveDir = V3_ADD(V3_SCALE(forward, controller->input_move.y * FixedDeltaTime * controller->movementSpeed.y),
+                         V3_SCALE(right, controller->input_move.x * FixedDeltaTime * controller->movementSpeed.x));
+        // Walking stays on the ground, the character controller handles height
+        moveDir.y = 0.0f;
     }
     // ============ Looking Around ============ //
     if (controller->input_look.x != 0 || controller->input_look.y != 0)
@@ -40,13 +44,13 @@ static void EC_Creature_FixedUpdate(Component *component)
         rot = Quat_Norm(rot);
         T_LRot_Set(ec_creature->transform, rot);
     }
-    // ============ Grounding ============ //
+    // ============ Character Controller ============ //
+    // A creature standing still on the ground stays where it is, skip the move
     V3 currentPos = T_WPos(ec_creature->transform);
-    if (!V3_EQUALS(currentPos, ec_creature->previousPos))
+    if (!V3_EQUALS(moveDir, V3_ZERO) || !ec_creature->characterController.isGrounded || !V3_EQUALS(currentPos, ec_creature->previousPos))
     {
-        EC_Island *ec_island = ec_creature->ec_island;
-        currentPos = EC_Island_GetPositionOnLand(ec_island, currentPos);
-        T_LPos_Set(ec_creature->transform, currentPos);
+        currentPos = CharacterController_Move(&ec_creature->characterController, currentPos, moveDir, FixedDeltaTime);
+        T_WPos_Set(ec_creature->transform, currentPos);
         ec_creature->previousPos = currentPos;
     }
     // ============ Vision ============ //
@@ -89,9 +93,14 @@ EC_Creature *EC_Creature_Create(EC_Island *ec_island, Entity *entity, CreatureTy
     CreatureVision_Init(&ec_creature->vision, distribution, 30.0f, fov, 20.0f, 0.6f, E_LAYER_CREATURE | E_LAYER_TREE | E_LAYER_DEFAULT, true);
     // Box Collider
     EC_Collider *collider = EC_Collider_Create(entity, (V3){0.0f, 0.9f, 0.0f}, false, EC_COLLIDER_BOX, (ColliderData){.box = {.scale = (V3){0.5f, 1.8f, 0.5f}}});
-    // Rigidbody
+    // Rigidbody, kept for the broadphase and raycasts. The character controller moves it, not the solver.
     RigidBodyConstraints constraints = RigidBodyConstraints_Humanoid();
-    EC_RigidBody_Create(entity, collider, 1.0f, false, constraints);
+    EC_RigidBody *ec_rigidbody = EC_RigidBody_Create(entity, collider, 1.0f, false, constraints);
+    PhysicsManager_SetKinematic(ec_rigidbody, true);
+    // Character Controller, a capsule matching the box collider
+    CharacterController_Init(&ec_creature->characterController, collider, 0.25f, 1.8f, 45.0f, 0.4f,
+                             (1u << E_LAYER_DEFAULT) | (1u << E_LAYER_TREE));
+    CharacterController_SetGround(&ec_creature->characterController, ec_island->heightfield, &ec_island->component->entity->transform);
     // Cache
     ec_creature->previousPos = (V3){0, 0, 0};
     // TODO: Feelings
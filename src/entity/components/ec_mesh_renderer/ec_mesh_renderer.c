@@ -28,7 +28,8 @@ static void EC_MeshRenderer_Free(Component *component)
     // Mark unreferenced
     Material_MarkUnreferenced(ec_meshRenderer->material);
     Mesh_MarkUnreferenced(ec_meshRenderer->mesh);
-    World_Renderer3D_Remove(ec_meshRenderer);
+    if (!Headless)
+        World_Renderer3D_Remove(ec_meshRenderer);
     free(ec_meshRenderer);
 }
 
@@ -51,7 +52,9 @@ EC_MeshRenderer *EC_MeshRenderer_Create(Entity *entity, Mesh *mesh, V3 meshScale
     EC_MeshRenderer_CalculateBounds(ec_meshRenderer);
     // Component
     ec_meshRenderer->component = Component_Create(ec_meshRenderer, entity, EC_T_RENDERER3D, EC_MeshRenderer_Free, NULL, NULL, NULL, NULL, NULL);
-    World_Renderer3D_Add(ec_meshRenderer);
+    // Headless renderers still hold their mesh and bounds for gameplay, but no camera draws them
+    if (!Headless)
+        World_Renderer3D_Add(ec_meshRenderer);
     return ec_meshRenderer;
 }
 
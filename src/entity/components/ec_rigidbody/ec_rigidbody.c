@@ -63,28 +63,15 @@ EC_RigidBody *EC_RigidBody_Create(Entity *entity, EC_Collider *ec_collider, floa
 {
     EC_RigidBody *ec_rigidbody = malloc(sizeof(EC_RigidBody));
     ec_rigidbody->ec_collider = ec_collider;
-    ec_rigidbody->mass = mass;
-    ec_rigidbody->useGravity = useGravity;
-    ec_rigidbody->isKinematic = false;
     ec_rigidbody->isStatic = &entity->isStatic;
-    // Transform
-    ec_rigidbody->w_pos = T_WPos(&entity->transform);
-    ec_rigidbody->w_rot = T_WRot(&entity->transform);
-    // Velocity
-    ec_rigidbody->velocity = V3_ZERO;
-    ec_rigidbody->angularVelocity = V3_ZERO;
-    ec_rigidbody->forceAccum = V3_ZERO;
-    ec_rigidbody->torqueAccum = V3_ZERO;
-    ec_rigidbody->linearDamping = 0.5f;  // Increased from 0.1f for better stability
-    ec_rigidbody->angularDamping = 0.5f; // Increased from 0.1f for better stability
-    // Sleeping system
-    ec_rigidbody->isSleeping = false;
-    ec_rigidbody->sleepTimer = 0.0f;
-    // Constraints
-    ec_rigidbody->constraints = constraints;
+    ec_rigidbody->handle = RIGIDBODY_HANDLE_NONE;
+    // Broadphase
+    ec_rigidbody->broadphaseProxy = SAP_PROXY_NONE;
+    ec_rigidbody->raycastProxy = SCENE_BVH_NONE;
+    ec_rigidbody->overlapProxy = SPATIAL_HASH_NONE;
     // Component
     ec_rigidbody->component = Component_Create(ec_rigidbody, entity, EC_T_RIGIDBODY, EC_RigidBody_Free, NULL, NULL, NULL, NULL, NULL);
     // Register with Physics Manager
-    PhysicsManager_RegisterRigidBody(ec_rigidbody);
+    PhysicsManager_RegisterRigidBody(ec_rigidbody, mass, useGravity, constraints);
     return ec_rigidbody;
 }
\ No newline at end of file
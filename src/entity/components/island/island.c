@@ -35,10 +35,11 @@ static void EC_Island_Free(Component* component){
     free(island);
 }
 
-static EC_Island* EC_Island_Create(Entity* entity, Noise* noise, EC_MeshRenderer* ec_meshRenderer_island){
+static EC_Island* EC_Island_Create(Entity* entity, Noise* noise, Heightfield* heightfield, EC_MeshRenderer* ec_meshRenderer_island){
     EC_Island* ec_island = malloc(sizeof(EC_Island));
     ec_island->ec_meshRenderer_island = ec_meshRenderer_island;
     ec_island->noise = noise;
+    ec_island->heightfield = heightfield;
     // Component
     ec_island->component = Component_Create(ec_island, entity, EC_T_ISLAND, EC_Island_Free, NULL, NULL, NULL, NULL, NULL);
     return ec_island;
@@ -61,9 +62,10 @@ EC_Island* Prefab_Island(Entity* parent, TransformSpace TS, V3 position, Quatern
     Noise_RecalculateMap(noise);
     // Create Mesh
     Mesh* islandMesh = Noise_CreateMesh(noise, meshScale, ISLAND_LAYERS_SIZE, ISLAND_LAYERS, true, NULL, 10, (V3){0.5, 0, 0.5});
-    // create Collider
-    ColliderData colliderData = {.mesh.mesh = islandMesh};
-    EC_Collider* ec_collider = EC_Collider_Create(entity, V3_ZERO, false, EC_COLLIDER_MESH, colliderData);
+    // Create Collider, sampling the noise map directly instead of the mesh's triangles
+    Heightfield* heightfield = Noise_CreateHeightfield(noise, meshScale, (V3){0.5, 0, 0.5});
+    ColliderData colliderData = {.heightfield.heightfield = heightfield};
+    EC_Collider* ec_collider = EC_Collider_Create(entity, V3_ZERO, false, EC_COLLIDER_HEIGHTFIELD, colliderData);
     // Temporary fix: add a rigidbody to the island so we can see it
     // EC_RigidBody* ec_rigidbody = EC_RigidBody_Create(entity, ec_collider, 0.0f, false, RigidBodyConstraints_FreezePosition());
     // Material
@@ -71,15 +73,17 @@ EC_Island* Prefab_Island(Entity* parent, TransformSpace TS, V3 position, Quatern
     Material* islandMaterial = Material_Create(islandShader, 0, NULL);
     EC_MeshRenderer* ec_meshRenderer_island = EC_MeshRenderer_Create(entity, islandMesh, meshScale, islandMaterial);
     // Island
-    EC_Island* e_island = EC_Island_Create(entity, noise, ec_meshRenderer_island);
+    EC_Island* e_island = EC_Island_Create(entity, noise, heightfield, ec_meshRenderer_island);
     return e_island;
 }
 
 inline V3 EC_Island_GetPositionOnLand(EC_Island* ec_island, V3 position){
-    Noise* noise = ec_island->noise;
-    EC_MeshRenderer *ec_meshRenderer = ec_island->ec_meshRenderer_island;
     V3 islandPos = EC_WPos(ec_island->component);
     V3 positionIslandSpace = V3_SUB(position, islandPos);
-    float yIslandSpace = Noise_GetMeshHeightAt(noise, positionIslandSpace, ec_meshRenderer->meshScale, ec_meshRenderer->mesh->pivot);
+    // Same surface the collider is raycast against
+    float yIslandSpace;
+    if(!Heightfield_GetHeight(ec_island->heightfield, positionIslandSpace.x, positionIslandSpace.z, &yIslandSpace)){
+        return position;
+    }
     return (V3){position.x, yIslandSpace + islandPos.y, position.z};
 }
\ No newline at end of file
@@ -446,6 +446,14 @@ V3 T_LEuler(Transform *transform)
 {
     return Quat_ToEuler(transform->l_rot);
 }
+void T_Clean(Transform *transform)
+{
+    if (transform->isDirty)
+    {
+        Transform_CleanFromTop(transform);
+    }
+}
+
 V3 T_WPos(Transform *transform)
 {
     if (transform->isDirty)
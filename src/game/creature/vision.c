@@ -156,12 +156,12 @@ void CreatureVision_PerformVision(CreatureVision *vision, V3 position, V3 forwar
             // Update the stored ray
             vision->rays[index].origin = V3_ADD(position, V3_SCALE(rayDirection, vision->offsetFromOrigin));
             vision->rays[index].direction = rayDirection;
-
-            // Perform the raycast
-            PhysicsManager_Raycast(&vision->rays[index], vision->viewDistance, &vision->raycastHits[index], vision->layermask);
         }
     }
 
+    // Cast the whole grid at once
+    PhysicsManager_RaycastBatch(vision->rays, vision->raycastHits_size, vision->viewDistance, vision->raycastHits, vision->layermask);
+
     // Update raycast renderer visuals
     if (vision->raycastRenderers != NULL)
     {
@@ -114,17 +114,21 @@ void Game_Awake()
         NULL);
 
     // ============ Camera ============ //
-    V3 cameraPosition = {5, 9, -20};
-    _ec_camera = Prefab_DisplayCamera(
-        _world->parent,
-        "Main Camera",
-        TS_WORLD,
-        cameraPosition,
-        Quat_FromEuler((V3){0, 0, 0}),
-        V3_ONE,
-        (V2){WindowConfig.imageWidth, WindowConfig.imageHeight});
-    EC_Camera_RemoveFromCullingMask(_ec_camera, E_LAYER_TRIGLE);
-    EC_CameraController_Create(_ec_camera->component->entity, _ec_camera, (V3){15.0, 15.0, 15.0});
+    // Nothing is rendered headless
+    if (!Headless)
+    {
+        V3 cameraPosition = {5, 9, -20};
+        _ec_camera = Prefab_DisplayCamera(
+            _world->parent,
+            "Main Camera",
+            TS_WORLD,
+            cameraPosition,
+            Quat_FromEuler((V3){0, 0, 0}),
+            V3_ONE,
+            (V2){WindowConfig.imageWidth, WindowConfig.imageHeight});
+        EC_Camera_RemoveFromCullingMask(_ec_camera, E_LAYER_TRIGLE);
+        EC_CameraController_Create(_ec_camera->component->entity, _ec_camera, (V3){15.0, 15.0, 15.0});
+    }
 
     // ============ Skybox ============ //
     // Entity *e_skybox = Entity_Create(_world->parent, true, "Skybox", TS_WORLD, V3_ZERO, QUATERNION_IDENTITY, V3_ONE);
@@ -230,15 +234,19 @@ void Game_Awake()
     // EC_Tree *ec_tree = Prefab_Tree(_world->parent, (V3){0.5, 0, 0});
 
     // ============ Test GUI ============ //
-    // Create a test GUI canvas
-    V2 resolution = {1280, 720};
-    EC_GUI *testGUI = Prefab_GUI(_world->parent, "Screen-Space GUI", GUI_RENDER_MODE_SCREEN_SPACE_OVERLAY, resolution, true);
-    // Create test text
-    TextFont *defaultFont = TextFont_GetDefault();
-    V3 textPos = {5.0f, 5.0f, 0.0f};
-    Prefab_W_Text(testGUI, NULL, defaultFont, "V0.1", 12, textPos, QUATERNION_IDENTITY, 0xffffffff);
-    Prefab_W_Text(testGUI, NULL, defaultFont, _world->name, 12, (V3){5.0f, 40.0f, 0.0f}, QUATERNION_IDENTITY, 0xffffffff);
-    Prefab_W_Text_DateTime(testGUI, testGUI->component->entity, defaultFont, 12, (V3){5.0f, 20, 0.0f}, QUATERNION_IDENTITY, 0xffffffff); // Dark Blue
+    // GUIs only draw through the camera
+    if (!Headless)
+    {
+        // Create a test GUI canvas
+        V2 resolution = {1280, 720};
+        EC_GUI *testGUI = Prefab_GUI(_world->parent, "Screen-Space GUI", GUI_RENDER_MODE_SCREEN_SPACE_OVERLAY, resolution, true);
+        // Create test text
+        TextFont *defaultFont = TextFont_GetDefault();
+        V3 textPos = {5.0f, 5.0f, 0.0f};
+        Prefab_W_Text(testGUI, NULL, defaultFont, "V0.1", 12, textPos, QUATERNION_IDENTITY, 0xffffffff);
+        Prefab_W_Text(testGUI, NULL, defaultFont, _world->name, 12, (V3){5.0f, 40.0f, 0.0f}, QUATERNION_IDENTITY, 0xffffffff);
+        Prefab_W_Text_DateTime(testGUI, testGUI->component->entity, defaultFont, 12, (V3){5.0f, 20, 0.0f}, QUATERNION_IDENTITY, 0xffffffff); // Dark Blue
+    }
 
     // ============ Call Awake ============ //
     for (int i = 0; i < _world->parent->transform.children_size; i++)
@@ -247,12 +255,16 @@ void Game_Awake()
     }
 
     // ============ WorldSpace GUI Test ============ //
-    EC_GUI *worldSpaceGUI = Prefab_GUI(_ec_player->component->entity, "World-Space GUI", GUI_RENDER_MODE_WORLD_SPACE, (V2){1280, 720}, true);
-    // Create 3D text
-    TextFont *default3DTextFont = TextFont_GetDefault();
-    W_Text *text3d = Prefab_W_Text(worldSpaceGUI, NULL, default3DTextFont, _ec_player->component->entity->name, 1, V3_ADD(playerPos, (V3){-1, 2, 0}), QUATERNION_IDENTITY, 0xffffffff);
-    T_WPos_Set(&text3d->component->entity->transform, V3_ADD(playerPos, (V3){0, 2, 0}));
-    T_WRot_Add(&text3d->component->entity->transform, (V3){180, 0, 0});
+    // GUIs only draw through the camera
+    if (!Headless)
+    {
+        EC_GUI *worldSpaceGUI = Prefab_GUI(_ec_player->component->entity, "World-Space GUI", GUI_RENDER_MODE_WORLD_SPACE, (V2){1280, 720}, true);
+        // Create 3D text
+        TextFont *default3DTextFont = TextFont_GetDefault();
+        W_Text *text3d = Prefab_W_Text(worldSpaceGUI, NULL, default3DTextFont, _ec_player->component->entity->name, 1, V3_ADD(playerPos, (V3){-1, 2, 0}), QUATERNION_IDENTITY, 0xffffffff);
+        T_WPos_Set(&text3d->component->entity->transform, V3_ADD(playerPos, (V3){0, 2, 0}));
+        T_WRot_Add(&text3d->component->entity->transform, (V3){180, 0, 0});
+    }
 
     // ============ Trigle ============ //
     // EC_Trigle *ec_trigle = Prefab_Trigle(_ec_camera->component->entity, "Trigle", TS_LOCAL, (V3){0, 0, 1}, Quat_FromEuler((V3){0, 180, 0}), V3_ONE);
@@ -287,6 +299,9 @@ void Game_Start()
 void Game_Update()
 {
     World_Select(_world);
+    // Draw bodies between their last two steps, Game_EndOfFrame puts the simulated poses back. Nothing draws headless
+    if (!Headless)
+        PhysicsManager_Interpolate(_world->physicsManager, FixedAlpha);
     World_Update();
 }
 
@@ -300,15 +315,20 @@ void Game_LateUpdate()
 
 void Game_FixedUpdate()
 {
-    PhysicsManager_FixedUpdate(_world->physicsManager);
+    // Finish the step the physics thread solved while the last frames rendered
+    PhysicsManager_EndStep(_world->physicsManager);
     for (int i = 0; i < _world->parent->transform.children_size; i++)
     {
         Entity_FixedUpdate(_world->parent->transform.children[i]->entity);
     }
+    // Hand the next step to the physics thread, it runs until the next Game_FixedUpdate
+    PhysicsManager_BeginStep(_world->physicsManager);
 }
 
 void Game_EndOfFrame()
 {
+    if (!Headless)
+        PhysicsManager_EndInterpolation(_world->physicsManager);
 }
 
 void Game_Free()
@@ -5,6 +5,8 @@
 #include <stdio.h>
 // Stack
 #include "utilities/stack.h"
+// Recording
+#include "input/input_recorder.h"
 // Logging
 #include "logging/logger.h"
 // OpenGL
@@ -85,10 +87,10 @@ static ButtonState *Context_GetButtonState(InputContext *context, int buttonId)
 }
 
 // -------------------------
-// GLFW Callbacks
+// Events
 // -------------------------
 
-static void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods)
+void InputManager_OnKey(int key, int action)
 {
     if (!_manager) return;
     
@@ -108,7 +110,7 @@ static void key_callback(GLFWwindow *window, int key, int scancode, int action,
     }
 }
 
-static void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
+void InputManager_OnButton(int button, int action)
 {
     if (!_manager) return;
     
@@ -127,7 +129,7 @@ static void mouse_button_callback(GLFWwindow *window, int button, int action, in
     }
 }
 
-static void cursor_position_callback(GLFWwindow *window, double xpos, double ypos)
+void InputManager_OnMotion(double xpos, double ypos)
 {
     if (!_manager) return;
     
@@ -154,6 +156,28 @@ static void cursor_position_callback(GLFWwindow *window, double xpos, double ypo
     }
 }
 
+// -------------------------
+// GLFW Callbacks
+// -------------------------
+
+static void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods)
+{
+    InputRecorder_Record(INPUT_EVENT_KEY, key, action, 0.0, 0.0);
+    InputManager_OnKey(key, action);
+}
+
+static void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
+{
+    InputRecorder_Record(INPUT_EVENT_BUTTON, button, action, 0.0, 0.0);
+    InputManager_OnButton(button, action);
+}
+
+static void cursor_position_callback(GLFWwindow *window, double xpos, double ypos)
+{
+    InputRecorder_Record(INPUT_EVENT_MOTION, 0, 0, xpos, ypos);
+    InputManager_OnMotion(xpos, ypos);
+}
+
 // -------------------------
 // Creation & Freeing
 // -------------------------
@@ -166,10 +190,13 @@ InputManager *InputManager_Create(GLFWwindow *window,char *name)
     manager->contexts = NULL;
     manager->contextStack = Stack_Create();
     manager->nextContextId = 0;
-    // Subscrive to GLFW input events
-    glfwSetKeyCallback(window, key_callback);
-    glfwSetMouseButtonCallback(window, mouse_button_callback);
-    glfwSetCursorPosCallback(window, cursor_position_callback);
+    // Subscrive to GLFW input events, there are none without a window
+    if (window)
+    {
+        glfwSetKeyCallback(window, key_callback);
+        glfwSetMouseButtonCallback(window, mouse_button_callback);
+        glfwSetCursorPosCallback(window, cursor_position_callback);
+    }
     // Log
     LogInit(&_logConfig, "Input Manager '%s' Created.", name);
     // Select InputManager
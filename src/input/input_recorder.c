@@ -0,0 +1,220 @@
+#include "input/input_recorder.h"
+// C
+#include <stdlib.h>
+#include <string.h>
+// Input
+#include "input/input_manager.h"
+// File
+#include "utilities/file/file.h"
+// Logging
+#include "logging/logger.h"
+
+// -------------------------
+// Static Variables
+// -------------------------
+
+static LogConfig _logConfig = {"InputRecorder", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
+static InputRecorder *_recorder = NULL;
+
+#define INPUT_RECORDING_MAGIC "PINP"
+#define INPUT_RECORDING_VERSION 1
+
+typedef struct InputRecordingHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t seed;
+    uint32_t frames;
+} InputRecordingHeader;
+
+/**
+ * @brief Recorded event, motions are followed by the cursor position as two floats
+ */
+typedef struct InputRecordingEvent
+{
+    uint32_t frame;
+    uint8_t type;
+    uint8_t action;
+    /// @brief Signed, GLFW reports keys it does not know as GLFW_KEY_UNKNOWN (-1)
+    int16_t code;
+} InputRecordingEvent;
+
+_Static_assert(sizeof(InputRecordingEvent) == 8, "InputRecordingEvent should stay packed");
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+static bool OpenRecording(InputRecorder *recorder, const char *path)
+{
+    recorder->file = fopen(path, "wb");
+    if (!recorder->file)
+        return false;
+    InputRecordingHeader header = {0};
+    memcpy(header.magic, INPUT_RECORDING_MAGIC, 4);
+    header.version = INPUT_RECORDING_VERSION;
+    header.seed = recorder->seed;
+    return fwrite(&header, sizeof(header), 1, recorder->file) == 1;
+}
+
+/**
+ * @brief Frames a recording spans, counted from its events when it was never closed and its header still reads 0.
+ * Frames after the last event are lost with the header, the replay ends on that event's frame.
+ */
+static uint32_t CountFrames(const InputRecorder *recorder, uint32_t headerFrames)
+{
+    if (headerFrames > 0)
+        return headerFrames;
+    uint32_t frames = 0;
+    size_t offset = sizeof(InputRecordingHeader);
+    while (offset + sizeof(InputRecordingEvent) <= recorder->data_size)
+    {
+        InputRecordingEvent event;
+        memcpy(&event, recorder->data + offset, sizeof(event));
+        offset += sizeof(event);
+        if (event.type == INPUT_EVENT_MOTION)
+        {
+            if (offset + 2 * sizeof(float) > recorder->data_size)
+                break;
+            offset += 2 * sizeof(float);
+        }
+        frames = event.frame + 1;
+    }
+    if (frames > 0)
+        LogWarning(&_logConfig, "The recording was not closed, replaying the %u frames up to its last event.", frames);
+    return frames;
+}
+
+static bool OpenReplay(InputRecorder *recorder, const char *path)
+{
+    recorder->data = File_Map(path, &recorder->data_size);
+    if (!recorder->data)
+        return false;
+    const InputRecordingHeader *header = (const InputRecordingHeader *)recorder->data;
+    if (recorder->data_size < sizeof(InputRecordingHeader) || memcmp(header->magic, INPUT_RECORDING_MAGIC, 4) != 0 ||
+        header->version != INPUT_RECORDING_VERSION)
+        return false;
+    recorder->seed = header->seed;
+    recorder->frames = CountFrames(recorder, header->frames);
+    recorder->data_offset = sizeof(InputRecordingHeader);
+    return true;
+}
+
+InputRecorder *InputRecorder_Create(const char *path, InputRecorderMode mode, uint32_t seed)
+{
+    InputRecorder *recorder = malloc(sizeof(InputRecorder));
+    memset(recorder, 0, sizeof(InputRecorder));
+    recorder->mode = mode;
+    recorder->seed = seed;
+    bool opened = mode == INPUT_RECORDER_RECORD ? OpenRecording(recorder, path) : OpenReplay(recorder, path);
+    if (!opened)
+    {
+        LogError(&_logConfig, "Could not open '%s' for %s.", path, mode == INPUT_RECORDER_RECORD ? "recording" : "replay");
+        InputRecorder_Free(recorder);
+        return NULL;
+    }
+    LogCreate(&_logConfig, "%s '%s', seed %u", mode == INPUT_RECORDER_RECORD ? "Recording to" : "Replaying", path, recorder->seed);
+    _recorder = recorder;
+    return recorder;
+}
+
+void InputRecorder_Free(InputRecorder *recorder)
+{
+    if (!recorder)
+        return;
+    if (recorder->file)
+    {
+        // The header goes first, its frame count is only known now
+        InputRecordingHeader header = {0};
+        memcpy(header.magic, INPUT_RECORDING_MAGIC, 4);
+        header.version = INPUT_RECORDING_VERSION;
+        header.seed = recorder->seed;
+        header.frames = recorder->frame;
+        if (fseek(recorder->file, 0, SEEK_SET) != 0 || fwrite(&header, sizeof(header), 1, recorder->file) != 1)
+        {
+            LogError(&_logConfig, "Could not finish the recording, it cannot be replayed.");
+        }
+        fclose(recorder->file);
+    }
+    if (recorder->data)
+    {
+        File_Unmap(recorder->data, recorder->data_size);
+    }
+    if (_recorder == recorder)
+    {
+        _recorder = NULL;
+    }
+    LogFree(&_logConfig, "%u frames", recorder->frame);
+    free(recorder);
+}
+
+// -------------------------
+// Frames
+// -------------------------
+
+void InputRecorder_BeginFrame()
+{
+    if (!_recorder || _recorder->mode != INPUT_RECORDER_REPLAY)
+        return;
+    while (_recorder->data_offset + sizeof(InputRecordingEvent) <= _recorder->data_size)
+    {
+        InputRecordingEvent event;
+        memcpy(&event, _recorder->data + _recorder->data_offset, sizeof(event));
+        if (event.frame != _recorder->frame)
+            break;
+        _recorder->data_offset += sizeof(event);
+        switch (event.type)
+        {
+        case INPUT_EVENT_KEY:
+            InputManager_OnKey(event.code, event.action);
+            break;
+        case INPUT_EVENT_BUTTON:
+            InputManager_OnButton(event.code, event.action);
+            break;
+        case INPUT_EVENT_MOTION:
+        {
+            float position[2];
+            if (_recorder->data_offset + sizeof(position) > _recorder->data_size)
+            {
+                _recorder->data_offset = _recorder->data_size;
+                return;
+            }
+            memcpy(position, _recorder->data + _recorder->data_offset, sizeof(position));
+            _recorder->data_offset += sizeof(position);
+            InputManager_OnMotion(position[0], position[1]);
+            break;
+        }
+        }
+    }
+}
+
+void InputRecorder_EndFrame()
+{
+    if (_recorder)
+    {
+        _recorder->frame++;
+    }
+}
+
+bool InputRecorder_IsFinished()
+{
+    return _recorder && _recorder->mode == INPUT_RECORDER_REPLAY && _recorder->frame >= _recorder->frames;
+}
+
+// -------------------------
+// Recording
+// -------------------------
+
+void InputRecorder_Record(InputEventType type, int code, int action, double x, double y)
+{
+    if (!_recorder || _recorder->mode != INPUT_RECORDER_RECORD)
+        return;
+    InputRecordingEvent event = {_recorder->frame, (uint8_t)type, (uint8_t)action, (int16_t)code};
+    fwrite(&event, sizeof(event), 1, _recorder->file);
+    if (type == INPUT_EVENT_MOTION)
+    {
+        // Stored as the float the input manager keeps, so the replay lands on the same position
+        float position[2] = {(float)x, (float)y};
+        fwrite(position, sizeof(position), 1, _recorder->file);
+    }
+}
@@ -5,11 +5,14 @@
 #include <time.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
 // Window
 #include "ui/window.h"
 // Input
 #include "input/input_manager.h"
+#include "input/input_recorder.h"
 // Logging
 #include "logging/logger.h"
 // Game
@@ -28,6 +31,8 @@
 #include "rendering/shader/shader.h"
 // Text
 #include "ui/text_font_manager.h"
+// Tasks
+#include "utilities/thread/task_pool.h"
 // OpenGL
 #define GLFW_INCLUDE_NONE
 #include <glad/glad.h>
@@ -35,7 +40,7 @@
 
 // Constants
 const int UPDATE_RATE_LIMIT = 60;
-const int FIXEDUPDATE_RATE_LIMIT = 40;
+const int FIXEDUPDATE_RATE_LIMIT = 20;
 const V3 WORLD_UP = {0, 1, 0};
 const vec3 WORLD_UP_vec3 = {0, 1, 0};
 const V3 WORLD_RIGHT = {1, 0, 0};
@@ -48,7 +53,9 @@ static float _desiredDeltaTime = 1 / (float)UPDATE_RATE_LIMIT;
 float DeltaTime = 1 / (float)UPDATE_RATE_LIMIT;
 float FixedDeltaTime = 1 / (float)FIXEDUPDATE_RATE_LIMIT;
 float PerceptronTime = 0.0f;
+float FixedAlpha = 0.0f;
 GLuint ShaderProgram;
+bool Headless = false;
 // Window configuration - imageWidth/Height is the low-res render target, windowWidth/Height is the actual window size
 const float m = 0.4f;
 MyWindowConfig WindowConfig = {(int)(1280 * m), (int)(720 * m), 1600, 900};
@@ -70,16 +77,26 @@ void framebuffer_size_callback(GLFWwindow *window, int width, int height)
            width, height, (int)WindowConfig.imageWidth, (int)WindowConfig.imageHeight);
 }
 
-int main()
+static double Now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// -------------------------
+// Window
+// -------------------------
+
+/// @brief Open the window and make its OpenGL 4.6 Core context current
+/// @return NULL on failure
+static GLFWwindow *Window_Open()
 {
-    // Set random seed
-    srand((unsigned int)time(NULL));
-    printf("Perceptron: Hello World.\n");
     // Initialize GLFW
     if (!glfwInit())
     {
         LogError(&_logConfig, "Failed to initialize GLFW");
-        return -1;
+        return NULL;
     }
 
     // Configure GLFW for OpenGL 4.6 Core
@@ -94,7 +111,7 @@ int main()
     {
         LogError(&_logConfig, "Failed to create GLFW window");
         glfwTerminate();
-        return -1;
+        return NULL;
     }
     LogSuccess(&_logConfig, "Window created successfully: %dx%d\n", WindowConfig.windowWidth, WindowConfig.windowHeight);
     // Make the OpenGL context current
@@ -104,7 +121,7 @@ int main()
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
     {
         LogError(&_logConfig, "Failed to initialize GLAD\n");
-        return -1;
+        return NULL;
     }
     // Configure OpenGL state
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
@@ -137,46 +154,44 @@ int main()
     glFrontFace(GL_CCW);    // Counter-clockwise = front
     // Hide and lock cursor to window
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+    return window;
+}
 
-    // ============ Input ============ //
-    InputManager *inputManager = InputManager_Create(window, "Perceptron Input Manager");
-
-    // ============ Shaders ============ //
-    ShaderManager *shaderManager = ShaderManager_Create();
-
-    // ============ Materials ============ //
-    MaterialManager *materialManager = MaterialManager_Create();
-
-    // ============ Meshes ============ //
-    MeshManager *meshManager = MeshManager_Create();
-
-    // ============ Textures ============ //
-    TextureManager *textureManager = TextureManager_Create();
+// -------------------------
+// Loops
+// -------------------------
 
-    // ============ 3D Renderers ============ //
-    Shader *toonShader = ShaderManager_Get(SHADER_TOON_SOLID);
-    Material *renderer3D_defaultMaterial = Material_Create(toonShader, 0, NULL);
-    EC_MeshRenderer_SetDefaultMaterial(renderer3D_defaultMaterial);
-
-    // ============ UI ============ //
-    // Text
-    TextFontManager *textFontManager = TextFontManager_Create(64, (V2){512, 512});
-    TextFont_Create("JetBrainsMono-Bold", "assets/fonts/JetBrainsMono-Bold.ttf");
+/// @brief Update, render and clean up one frame
+/// @param window NULL when headless
+static void Frame(GLFWwindow *window)
+{
+    // Update Loop
+    Game_Update();
+    // Late Update Loop
+    Game_LateUpdate();
+    if (window)
+    {
+        glfwSwapBuffers(window);
+    }
+    Game_EndOfFrame();
+    // Input
+    InputManager_ResetInputs();
 
-    // ============ Start Infinite Loop ============ //
-    Game_Awake();
-    Game_Start();
+    // End-of-Frame Cleanup
+    MeshManager_Cleanup();
+    MaterialManager_Cleanup();
+    TextureManager_Cleanup();
+}
 
+static void Loop_Window(GLFWwindow *window)
+{
     double fixedAccumulator = 0.0;
     double updateAccumulator = 0.0;
     int maxPhysicsSteps = 5;
     int physicsSteps = 0;
     // FPS
     int frameCounter = 0;
-    // Temporary Variables
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    double lastTime = ts.tv_sec + ts.tv_nsec * 1e-9;
+    double lastTime = Now();
     double frameTimer = 0.0;
     // Infinite Loop
     bool isRunning = true;
@@ -191,14 +206,22 @@ int main()
 
         glfwPollEvents();
         // Measure Time
-        clock_gettime(CLOCK_MONOTONIC, &ts);
-        double now = ts.tv_sec + ts.tv_nsec * 1e-9;
+        double now = Now();
         float time = now - lastTime;
         lastTime = now;
         fixedAccumulator += time;
         updateAccumulator += time;
         PerceptronTime += time;
         frameTimer += time;
+        // Fixed steps first, so the frame below renders while the physics thread solves the last one
+        while (fixedAccumulator >= FixedDeltaTime && physicsSteps <= maxPhysicsSteps)
+        {
+            physicsSteps++;
+            Game_FixedUpdate();
+            fixedAccumulator -= FixedDeltaTime;
+        }
+        physicsSteps = 0;
+        FixedAlpha = fixedAccumulator < FixedDeltaTime ? (float)(fixedAccumulator / FixedDeltaTime) : 1.0f;
         // Update Entities
         if (updateAccumulator >= _desiredDeltaTime)
         {
@@ -212,29 +235,188 @@ int main()
                 frameCounter = 0;
                 frameTimer -= 1.0;
             }
-            // Update Loop
-            Game_Update();
-            // Late Update Loop
-            Game_LateUpdate();
-            glfwSwapBuffers(window);
-            Game_EndOfFrame();
-            // Input
-            InputManager_ResetInputs();
-
-            // End-of-Frame Cleanup
-            MeshManager_Cleanup();
-            MaterialManager_Cleanup();
-            TextureManager_Cleanup();
+            Frame(window);
         }
-        while (fixedAccumulator >= FixedDeltaTime && physicsSteps <= maxPhysicsSteps)
+    }
+}
+
+/**
+ * @brief Run frames on a simulated clock: every frame advances time by exactly DeltaTime, so fixed
+ * steps, DeltaTime and the world's simulated date stay in the same ratio as with a window, whatever the speed.
+ * The same frames always run the same fixed steps, which recordings rely on to replay identically.
+ * @param window NULL when headless
+ * @param speed Simulated seconds per real second, 0 to run as fast as the CPU allows
+ * @param maxFixedSteps Fixed steps to run before returning, 0 to run forever
+ */
+static void Loop_Fixed(GLFWwindow *window, double speed, long maxFixedSteps)
+{
+    double fixedAccumulator = 0.0;
+    long fixedSteps = 0;
+    double startTime = Now();
+    // Rate
+    double reportTime = startTime;
+    long reportSteps = 0;
+    while (maxFixedSteps == 0 || fixedSteps < maxFixedSteps)
+    {
+        if (window)
+        {
+            if (glfwWindowShouldClose(window))
+            {
+                Log(&_logConfig, "GLFW Window close requested. Exiting Main Loop...");
+                break;
+            }
+            glfwPollEvents();
+        }
+        if (InputRecorder_IsFinished())
+        {
+            Log(&_logConfig, "Replay finished. Exiting Main Loop...");
+            break;
+        }
+        InputRecorder_BeginFrame();
+        PerceptronTime += _desiredDeltaTime;
+        fixedAccumulator += _desiredDeltaTime;
+        while (fixedAccumulator >= FixedDeltaTime && (maxFixedSteps == 0 || fixedSteps < maxFixedSteps))
         {
-            physicsSteps++;
             Game_FixedUpdate();
             fixedAccumulator -= FixedDeltaTime;
+            fixedSteps++;
         }
-        // Cleanup
+        FixedAlpha = fixedAccumulator < FixedDeltaTime ? (float)(fixedAccumulator / FixedDeltaTime) : 1.0f;
+        Frame(window);
+        InputRecorder_EndFrame();
 
-        physicsSteps = 0;
+        double now = Now();
+        // Stay behind speed x real time
+        if (speed > 0.0)
+        {
+            double ahead = PerceptronTime / speed - (now - startTime);
+            if (ahead > 0.0)
+            {
+                usleep((useconds_t)(ahead * 1e6));
+                now = Now();
+            }
+        }
+        if (now - reportTime >= 1.0)
+        {
+            Log(&_logConfig, "Fixed clock: %.0f fixed steps/s, %.1fx real time",
+                (fixedSteps - reportSteps) / (now - reportTime), PerceptronTime / (now - startTime));
+            reportTime = now;
+            reportSteps = fixedSteps;
+        }
+    }
+    double elapsed = Now() - startTime;
+    LogSuccess(&_logConfig, "Fixed clock: ran %ld fixed steps (%.1fs simulated) in %.2fs.", fixedSteps, PerceptronTime, elapsed);
+}
+
+// -------------------------
+// Main
+// -------------------------
+
+/**
+ * Arguments:
+ * --headless       No window, OpenGL context or rendering, frames run back to back
+ * --speed <x>      Headless only, simulated seconds per real second (default 0: as fast as possible)
+ * --steps <n>      Headless only, quit after n fixed steps (default 0: never)
+ * --record <file>  Write the seed and the input of every frame to file, frames run on the fixed clock at real time
+ * --replay <file>  Replay a recording instead of listening to the window, then quit
+ */
+int main(int argc, char **argv)
+{
+    double headlessSpeed = 0.0;
+    long headlessSteps = 0;
+    const char *recordPath = NULL;
+    const char *replayPath = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--headless") == 0)
+            Headless = true;
+        else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc)
+            headlessSpeed = strtod(argv[++i], NULL);
+        else if (strcmp(argv[i], "--steps") == 0 && i + 1 < argc)
+            headlessSteps = strtol(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            replayPath = argv[++i];
+        else
+            LogWarning(&_logConfig, "Ignoring unknown argument '%s'", argv[i]);
+    }
+    printf("Perceptron: Hello World.\n");
+
+    // ============ Window ============ //
+    GLFWwindow *window = NULL;
+    if (!Headless)
+    {
+        window = Window_Open();
+        if (!window)
+            return -1;
+    }
+
+    // ============ Recording ============ //
+    // A replay takes the seed of its recording
+    uint32_t seed = (uint32_t)time(NULL);
+    InputRecorder *inputRecorder = NULL;
+    if (replayPath || recordPath)
+    {
+        inputRecorder = replayPath ? InputRecorder_Create(replayPath, INPUT_RECORDER_REPLAY, seed)
+                                   : InputRecorder_Create(recordPath, INPUT_RECORDER_RECORD, seed);
+        if (!inputRecorder)
+            return -1;
+        seed = inputRecorder->seed;
+    }
+    // Set random seed
+    srand(seed);
+    Log(&_logConfig, "Random seed: %u", seed);
+
+    // ============ Input ============ //
+    // A replay is the only source of input
+    InputManager *inputManager = InputManager_Create(replayPath ? NULL : window, "Perceptron Input Manager");
+
+    // ============ Tasks ============ //
+    // The main thread helps while waiting, so one worker per remaining hardware thread
+    TaskPool *taskPool = TaskPool_Create(TaskPool_HardwareThreads() - 1);
+
+    // ============ Shaders ============ //
+    ShaderManager *shaderManager = ShaderManager_Create();
+
+    // ============ Materials ============ //
+    MaterialManager *materialManager = MaterialManager_Create();
+
+    // ============ Meshes ============ //
+    MeshManager *meshManager = MeshManager_Create();
+
+    // ============ Textures ============ //
+    TextureManager *textureManager = TextureManager_Create();
+
+    // ============ 3D Renderers ============ //
+    Shader *toonShader = ShaderManager_Get(SHADER_TOON_SOLID);
+    Material *renderer3D_defaultMaterial = Material_Create(toonShader, 0, NULL);
+    EC_MeshRenderer_SetDefaultMaterial(renderer3D_defaultMaterial);
+
+    // ============ UI ============ //
+    // Text, only drawn by the GUIs a window has
+    TextFontManager *textFontManager = NULL;
+    if (!Headless)
+    {
+        textFontManager = TextFontManager_Create(64, (V2){512, 512});
+        TextFont_Create("JetBrainsMono-Bold", "assets/fonts/JetBrainsMono-Bold.ttf");
+    }
+
+    // ============ Start Infinite Loop ============ //
+    Game_Awake();
+    Game_Start();
+
+    if (Headless)
+    {
+        Loop_Fixed(NULL, headlessSpeed, headlessSteps);
+    }
+    else if (inputRecorder)
+    {
+        Loop_Fixed(window, 1.0, 0);
+    }
+    else
+    {
+        Loop_Window(window);
     }
 
     // -------------------------
@@ -242,6 +424,7 @@ int main()
     // -------------------------
     // Input
     InputManager_Free(inputManager);
+    InputRecorder_Free(inputRecorder);
     // Game
     Game_Free();
     // Meshes
@@ -253,11 +436,19 @@ int main()
     // Textures
     TextureManager_Free(textureManager);
     // UI
-    TextFontManager_Free(textFontManager);
+    if (textFontManager)
+    {
+        TextFontManager_Free(textFontManager);
+    }
+    // Tasks
+    TaskPool_Free(taskPool);
     // Cleanup GLFW
-    glDeleteProgram(ShaderProgram);
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    if (window)
+    {
+        glDeleteProgram(ShaderProgram);
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
 
     return 0;
-}
\ No newline at end of file
+}
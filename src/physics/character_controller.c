@@ -0,0 +1,279 @@
+#include "physics/character_controller.h"
+// Physics
+#include "physics/physics-manager.h"
+// Collider
+#include "entity/components/ec_collider/ec_collider.h"
+// C
+#include <math.h>
+#include <float.h>
+
+// -------------------------
+// Constants
+// -------------------------
+
+// Static colliders considered per move, the closest ones are not guaranteed beyond that
+#define CHARACTER_MAX_OBSTACLES 32
+// Walls slid along per move
+#define CHARACTER_MAX_SLIDES 3
+// Distance kept from walls, so the next move does not start inside them
+#define CHARACTER_SKIN_WIDTH 0.01f
+#define CHARACTER_DEFAULT_SNAP_DISTANCE 0.3f
+
+// -------------------------
+// Helpers
+// -------------------------
+
+/**
+ * @brief World height of the ground under world (x, z). Upright grounds, only turned around Y, are sampled directly
+ * in their local space; tilted ones are raycast straight down.
+ * @note World to local is local = S^-1 * R^T * (p - worldPos), like heightfield raycasts
+ */
+static bool GroundHeight(const CharacterController *controller, float x, float z, float *outHeight)
+{
+    if (!controller->ground)
+        return false;
+    if (!controller->groundTransform)
+        return Heightfield_GetHeight(controller->ground, x, z, outHeight);
+
+    Transform *transform = controller->groundTransform;
+    V3 worldPos = T_WPos(transform);
+    V3 worldScale = T_WSca(transform);
+    V3 right = T_Right(transform);
+    V3 up = T_Up(transform);
+    V3 forward = T_Forward(transform);
+    if (worldScale.x == 0.0f || worldScale.y == 0.0f || worldScale.z == 0.0f)
+        return false;
+    V3 invScale = {1.0f / worldScale.x, 1.0f / worldScale.y, 1.0f / worldScale.z};
+
+    // (x, worldPos.y, z) in local space
+    V3 relative = {x - worldPos.x, 0.0f, z - worldPos.z};
+    V3 localPoint = V3_MUL((V3){V3_DOT(relative, right), V3_DOT(relative, up), V3_DOT(relative, forward)}, invScale);
+    float localHeight;
+    if (up.y > 0.9999f)
+    {
+        // The vertical through (x, z) stays vertical in local space
+        if (!Heightfield_GetHeight(controller->ground, localPoint.x, localPoint.z, &localHeight))
+            return false;
+        *outHeight = worldPos.y + localHeight * worldScale.y;
+        return true;
+    }
+
+    // Start far enough above the point to be outside the ground's bounds, distances along it are in world units
+    const AABB *bounds = &controller->ground->bounds;
+    V3 localDown = V3_MUL((V3){-right.y, -up.y, -forward.y}, invScale);
+    V3 center = V3_SCALE(V3_ADD(bounds->min, bounds->max), 0.5f);
+    float reach = V3_MAGNITUDE(V3_MUL(V3_SUB(localPoint, center), worldScale)) +
+                  V3_MAGNITUDE(V3_MUL(V3_SUB(bounds->max, bounds->min), worldScale)) * 0.5f + 1.0f;
+    V3 localStart = V3_SUB(localPoint, V3_SCALE(localDown, reach));
+    float distance;
+    V3 localNormal;
+    if (!Heightfield_Raycast(controller->ground, localStart, localDown, 2.0f * reach, &distance, &localNormal))
+        return false;
+    *outHeight = worldPos.y + reach - distance;
+    return true;
+}
+
+/// @brief Normal of the ground from the heights one sample apart around (x, z)
+static V3 GroundNormal(const CharacterController *controller, float x, float z)
+{
+    float dx = controller->ground->spacing.x;
+    float dz = controller->ground->spacing.z;
+    float left, right, back, front;
+    if (!GroundHeight(controller, x - dx, z, &left) || !GroundHeight(controller, x + dx, z, &right) ||
+        !GroundHeight(controller, x, z - dz, &back) || !GroundHeight(controller, x, z + dz, &front))
+        return (V3){0.0f, 1.0f, 0.0f};
+    return V3_NORM((V3){(left - right) * dz, 2.0f * dx * dz, (back - front) * dx});
+}
+
+/**
+ * @brief Sweep the capsule's footprint, a circle approximated by its square, against a box on the XZ plane
+ * @return false if the move misses the box or starts inside it
+ */
+static bool SweepFootprint(V3 start, V3 move, float radius, AABB box, float *outTime, V3 *outNormal)
+{
+    float min[2] = {box.min.x - radius, box.min.z - radius};
+    float max[2] = {box.max.x + radius, box.max.z + radius};
+    float origin[2] = {start.x, start.z};
+    float direction[2] = {move.x, move.z};
+    float tEnter = -FLT_MAX;
+    float tExit = FLT_MAX;
+    int enterAxis = 0;
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (fabsf(direction[axis]) < 1e-8f)
+        {
+            if (origin[axis] <= min[axis] || origin[axis] >= max[axis])
+                return false;
+            continue;
+        }
+        float t1 = (min[axis] - origin[axis]) / direction[axis];
+        float t2 = (max[axis] - origin[axis]) / direction[axis];
+        if (t1 > t2)
+        {
+            float swap = t1;
+            t1 = t2;
+            t2 = swap;
+        }
+        if (t1 > tEnter)
+        {
+            tEnter = t1;
+            enterAxis = axis;
+        }
+        tExit = fminf(tExit, t2);
+    }
+    if (tEnter < 0.0f || tEnter > 1.0f || tEnter > tExit)
+        return false;
+    *outTime = tEnter;
+    *outNormal = enterAxis == 0 ? (V3){direction[0] > 0.0f ? -1.0f : 1.0f, 0.0f, 0.0f}
+                                : (V3){0.0f, 0.0f, direction[1] > 0.0f ? -1.0f : 1.0f};
+    return true;
+}
+
+/// @brief Highest surface under the feet that is low enough to stand on: the ground or the top of a low obstacle
+/// @param feet Height the step limit is measured from
+static bool FindSupport(const CharacterController *controller, const AABB *obstacles, int obstacles_size, V3 position,
+                        float feet, float *outHeight, V3 *outNormal)
+{
+    bool found = GroundHeight(controller, position.x, position.z, outHeight);
+    if (found)
+        *outNormal = GroundNormal(controller, position.x, position.z);
+    for (int i = 0; i < obstacles_size; i++)
+    {
+        AABB obstacle = obstacles[i];
+        if (position.x < obstacle.min.x || position.x > obstacle.max.x || position.z < obstacle.min.z || position.z > obstacle.max.z)
+            continue;
+        if (obstacle.max.y > feet + controller->stepHeight || (found && obstacle.max.y <= *outHeight))
+            continue;
+        *outHeight = obstacle.max.y;
+        *outNormal = (V3){0.0f, 1.0f, 0.0f};
+        found = true;
+    }
+    return found;
+}
+
+/// @brief World bounds of the static colliders the capsule may touch while moving by displacement
+static int GatherObstacles(const CharacterController *controller, V3 position, V3 displacement, AABB *outObstacles)
+{
+    float reach = controller->radius + CHARACTER_SKIN_WIDTH;
+    float bottom = position.y + fminf(displacement.y, 0.0f) - controller->snapDistance - controller->stepHeight;
+    float top = position.y + fmaxf(displacement.y, 0.0f) + controller->height;
+    V3 center = {position.x + displacement.x * 0.5f, (bottom + top) * 0.5f, position.z + displacement.z * 0.5f};
+    V3 halfExtents = {reach + fabsf(displacement.x) * 0.5f, (top - bottom) * 0.5f, reach + fabsf(displacement.z) * 0.5f};
+    EC_Collider *colliders[CHARACTER_MAX_OBSTACLES];
+    int colliders_size = PhysicsManager_BoxCast(center, halfExtents, colliders, CHARACTER_MAX_OBSTACLES, controller->layerMask);
+    int obstacles_size = 0;
+    for (int i = 0; i < colliders_size; i++)
+    {
+        EC_Collider *collider = colliders[i];
+        // The ground is sampled directly, its bounds would block everything above it
+        if (collider == controller->self || collider->isTrigger || !*collider->isStatic || collider->type == EC_COLLIDER_HEIGHTFIELD)
+            continue;
+        outObstacles[obstacles_size++] = collider->worldAABB;
+    }
+    return obstacles_size;
+}
+
+// -------------------------
+// Initialization
+// -------------------------
+
+void CharacterController_Init(CharacterController *controller, EC_Collider *self, float radius, float height, float slopeLimit,
+                              float stepHeight, uint32_t layerMask)
+{
+    controller->radius = radius;
+    controller->height = height;
+    controller->slopeLimit = cosf(slopeLimit * (float)M_PI / 180.0f);
+    controller->stepHeight = stepHeight;
+    controller->snapDistance = CHARACTER_DEFAULT_SNAP_DISTANCE;
+    controller->layerMask = layerMask;
+    controller->self = self;
+    controller->ground = NULL;
+    controller->groundTransform = NULL;
+    controller->isGrounded = false;
+    controller->groundNormal = (V3){0.0f, 1.0f, 0.0f};
+    controller->fallSpeed = 0.0f;
+}
+
+void CharacterController_SetGround(CharacterController *controller, const Heightfield *ground, Transform *groundTransform)
+{
+    controller->ground = ground;
+    controller->groundTransform = groundTransform;
+}
+
+// -------------------------
+// Movement
+// -------------------------
+
+V3 CharacterController_Move(CharacterController *controller, V3 position, V3 displacement, float deltaTime)
+{
+    // Gravity only pulls while airborne, walking keeps the feet on the ground through snapping
+    if (!controller->isGrounded)
+    {
+        controller->fallSpeed += PhysicsManager_GetGravity().y * deltaTime;
+        displacement.y += controller->fallSpeed * deltaTime;
+    }
+    AABB obstacles[CHARACTER_MAX_OBSTACLES];
+    int obstacles_size = GatherObstacles(controller, position, displacement, obstacles);
+
+    // ============ Horizontal ============ //
+    // Walls block and are slid along, obstacles low enough to step onto are left to the support below
+    V3 start = position;
+    V3 remaining = {displacement.x, 0.0f, displacement.z};
+    for (int slide = 0; slide < CHARACTER_MAX_SLIDES && (remaining.x != 0.0f || remaining.z != 0.0f); slide++)
+    {
+        float hitTime = 1.0f;
+        V3 hitNormal = V3_ZERO;
+        for (int i = 0; i < obstacles_size; i++)
+        {
+            AABB obstacle = obstacles[i];
+            if (obstacle.max.y <= position.y + controller->stepHeight || obstacle.min.y >= position.y + controller->height)
+                continue;
+            float time;
+            V3 normal;
+            if (SweepFootprint(position, remaining, controller->radius, obstacle, &time, &normal) && time < hitTime)
+            {
+                hitTime = time;
+                hitNormal = normal;
+            }
+        }
+        position = V3_ADD(position, V3_SCALE(remaining, hitTime));
+        if (hitTime >= 1.0f)
+            break;
+        position = V3_ADD(position, V3_SCALE(hitNormal, CHARACTER_SKIN_WIDTH));
+        // Keep the part of the rest of the move that runs along the wall
+        V3 rest = V3_SCALE(remaining, 1.0f - hitTime);
+        remaining = V3_SUB(rest, V3_SCALE(hitNormal, V3_DOT(rest, hitNormal)));
+    }
+
+    // ============ Slope Limit ============ //
+    float startHeight, endHeight;
+    if (controller->isGrounded && GroundHeight(controller, start.x, start.z, &startHeight) &&
+        GroundHeight(controller, position.x, position.z, &endHeight) && endHeight > startHeight &&
+        GroundNormal(controller, position.x, position.z).y < controller->slopeLimit)
+    {
+        position.x = start.x;
+        position.z = start.z;
+    }
+
+    // ============ Vertical ============ //
+    position.y += displacement.y;
+    float supportHeight;
+    V3 supportNormal;
+    // Measured from before the fall, so a fast fall still lands on what it passed through
+    bool hasSupport = FindSupport(controller, obstacles, obstacles_size, position, fmaxf(start.y, position.y),
+                                  &supportHeight, &supportNormal);
+    // Land when falling through the support, stay snapped to it when walking off a small ledge or down a slope
+    if (hasSupport && (position.y <= supportHeight || (controller->isGrounded && position.y - supportHeight <= controller->snapDistance)))
+    {
+        position.y = supportHeight;
+        controller->isGrounded = true;
+        controller->groundNormal = supportNormal;
+        controller->fallSpeed = 0.0f;
+    }
+    else
+    {
+        controller->isGrounded = false;
+        controller->groundNormal = (V3){0.0f, 1.0f, 0.0f};
+    }
+    return position;
+}
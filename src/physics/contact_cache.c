@@ -0,0 +1,178 @@
+#include "physics/contact_cache.h"
+// C
+#include <stdlib.h>
+#include <string.h>
+// Logging
+#include "logging/logger.h"
+
+// -------------------------
+// Static Variables
+// -------------------------
+
+static LogConfig _logConfig = {"ContactCache", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
+
+// -------------------------
+// Helpers
+// -------------------------
+
+#define CONTACT_KEY_EMPTY UINT64_MAX
+#define CONTACT_KEY_TOMBSTONE (UINT64_MAX - 1)
+#define CONTACT_MIN_CAPACITY 64
+
+inline static uint64_t PairKey(uint32_t bodyA, uint32_t bodyB)
+{
+    return bodyA < bodyB ? ((uint64_t)bodyA << 32) | bodyB : ((uint64_t)bodyB << 32) | bodyA;
+}
+
+/// @brief 64-bit finalizer of MurmurHash3, spreads consecutive handles over the whole table
+inline static size_t HashKey(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return (size_t)key;
+}
+
+static void ClearEntries(ContactEntry *entries, size_t capacity)
+{
+    for (size_t i = 0; i < capacity; i++)
+    {
+        entries[i].key = CONTACT_KEY_EMPTY;
+    }
+}
+
+/// @brief Move the live pairs into a table of the given capacity, dropping the tombstones
+static void Rehash(ContactCache *cache, size_t capacity)
+{
+    ContactEntry *old = cache->entries;
+    size_t oldCapacity = cache->entries_capacity;
+    cache->entries = malloc(sizeof(ContactEntry) * capacity);
+    cache->entries_capacity = capacity;
+    ClearEntries(cache->entries, capacity);
+    size_t mask = capacity - 1;
+    for (size_t i = 0; i < oldCapacity; i++)
+    {
+        if (old[i].key >= CONTACT_KEY_TOMBSTONE)
+            continue;
+        size_t slot = HashKey(old[i].key) & mask;
+        while (cache->entries[slot].key != CONTACT_KEY_EMPTY)
+        {
+            slot = (slot + 1) & mask;
+        }
+        cache->entries[slot] = old[i];
+    }
+    cache->used = cache->size;
+    free(old);
+}
+
+// -------------------------
+// Steps
+// -------------------------
+
+void ContactCache_BeginStep(ContactCache *cache)
+{
+    cache->stamp++;
+}
+
+bool ContactCache_Touch(ContactCache *cache, uint32_t bodyA, uint32_t bodyB, EC_Collider *colliderA, EC_Collider *colliderB)
+{
+    // Keep the load under one half, linear probing degrades quickly past that
+    if ((cache->used + 1) * 2 > cache->entries_capacity)
+    {
+        size_t capacity = cache->entries_capacity;
+        while ((cache->size + 1) * 4 > capacity)
+        {
+            capacity *= 2;
+        }
+        Rehash(cache, capacity);
+    }
+    uint64_t key = PairKey(bodyA, bodyB);
+    size_t mask = cache->entries_capacity - 1;
+    size_t slot = HashKey(key) & mask;
+    size_t tombstone = SIZE_MAX;
+    while (cache->entries[slot].key != CONTACT_KEY_EMPTY)
+    {
+        if (cache->entries[slot].key == key)
+        {
+            cache->entries[slot].stamp = cache->stamp;
+            return true;
+        }
+        if (cache->entries[slot].key == CONTACT_KEY_TOMBSTONE && tombstone == SIZE_MAX)
+        {
+            tombstone = slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    if (tombstone != SIZE_MAX)
+    {
+        slot = tombstone;
+    }
+    else
+    {
+        cache->used++;
+    }
+    cache->entries[slot] = (ContactEntry){key, colliderA, colliderB, cache->stamp};
+    cache->size++;
+    return false;
+}
+
+void ContactCache_EndStep(ContactCache *cache, ContactEndedCallback onEnded, void *context)
+{
+    for (size_t i = 0; i < cache->entries_capacity; i++)
+    {
+        ContactEntry *entry = &cache->entries[i];
+        if (entry->key >= CONTACT_KEY_TOMBSTONE || entry->stamp == cache->stamp)
+            continue;
+        if (onEnded && !onEnded(context, (uint32_t)(entry->key >> 32), (uint32_t)entry->key, entry->colliderA, entry->colliderB))
+            continue;
+        // The callback may have removed one of the bodies already
+        if (entry->key < CONTACT_KEY_TOMBSTONE)
+        {
+            entry->key = CONTACT_KEY_TOMBSTONE;
+            cache->size--;
+        }
+    }
+}
+
+void ContactCache_RemoveBody(ContactCache *cache, uint32_t body)
+{
+    if (cache->size == 0)
+        return;
+    for (size_t i = 0; i < cache->entries_capacity; i++)
+    {
+        uint64_t key = cache->entries[i].key;
+        if (key >= CONTACT_KEY_TOMBSTONE)
+            continue;
+        if ((uint32_t)(key >> 32) == body || (uint32_t)key == body)
+        {
+            cache->entries[i].key = CONTACT_KEY_TOMBSTONE;
+            cache->size--;
+        }
+    }
+}
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+ContactCache *ContactCache_Create()
+{
+    ContactCache *cache = malloc(sizeof(ContactCache));
+    memset(cache, 0, sizeof(ContactCache));
+    cache->entries_capacity = CONTACT_MIN_CAPACITY;
+    cache->entries = malloc(sizeof(ContactEntry) * cache->entries_capacity);
+    ClearEntries(cache->entries, cache->entries_capacity);
+    LogCreate(&_logConfig, "");
+    return cache;
+}
+
+void ContactCache_Free(ContactCache *cache)
+{
+    if (!cache)
+        return;
+    free(cache->entries);
+    free(cache);
+    LogFree(&_logConfig, "");
+}
@@ -0,0 +1,358 @@
+#include "physics/heightfield.h"
+// C
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+// Logging
+#include "logging/logger.h"
+
+// -------------------------
+// Static Variables
+// -------------------------
+
+static LogConfig _logConfig = {"Heightfield", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
+
+// -------------------------
+// Helpers
+// -------------------------
+
+/// @brief Same expression Noise_CreateMesh uses, so hits land exactly on the rendered surface
+static inline V3 SamplePosition(const Heightfield *heightfield, int x, int z)
+{
+    return (V3){
+        x * heightfield->spacing.x + heightfield->origin.x,
+        heightfield->map[x][z] * heightfield->spacing.y + heightfield->origin.y,
+        z * heightfield->spacing.z + heightfield->origin.z};
+}
+
+static inline float SampleHeight(const Heightfield *heightfield, int x, int z)
+{
+    return heightfield->map[x][z] * heightfield->spacing.y + heightfield->origin.y;
+}
+
+/// @brief Bounds of a block, level 0 being single cells read from the map
+static HeightfieldBlock GetBlock(const Heightfield *heightfield, int level, int x, int z)
+{
+    if (level > 0)
+    {
+        const HeightfieldLevel *l = &heightfield->levels[level - 1];
+        return l->blocks[z * l->width + x];
+    }
+    float h00 = SampleHeight(heightfield, x, z);
+    float h10 = SampleHeight(heightfield, x + 1, z);
+    float h01 = SampleHeight(heightfield, x, z + 1);
+    float h11 = SampleHeight(heightfield, x + 1, z + 1);
+    return (HeightfieldBlock){
+        fminf(fminf(h00, h10), fminf(h01, h11)),
+        fmaxf(fmaxf(h00, h10), fmaxf(h01, h11))};
+}
+
+static void FreeLevels(Heightfield *heightfield)
+{
+    for (size_t i = 0; i < heightfield->levels_size; i++)
+    {
+        free(heightfield->levels[i].blocks);
+    }
+    free(heightfield->levels);
+    heightfield->levels = NULL;
+    heightfield->levels_size = 0;
+}
+
+/// @brief Build every level by merging 2x2 blocks of the one below, until a single block covers the grid
+static void BuildLevels(Heightfield *heightfield)
+{
+    int cellsX = heightfield->width - 1;
+    int cellsZ = heightfield->height - 1;
+    size_t capacity = 1;
+    for (int size = 2; size < cellsX || size < cellsZ; size *= 2)
+        capacity++;
+    heightfield->levels = malloc(sizeof(HeightfieldLevel) * capacity);
+
+    int belowWidth = cellsX, belowHeight = cellsZ;
+    for (size_t i = 0; i < capacity; i++)
+    {
+        HeightfieldLevel *level = &heightfield->levels[i];
+        level->width = (belowWidth + 1) / 2;
+        level->height = (belowHeight + 1) / 2;
+        level->blocks = malloc(sizeof(HeightfieldBlock) * level->width * level->height);
+        for (int z = 0; z < level->height; z++)
+        {
+            for (int x = 0; x < level->width; x++)
+            {
+                HeightfieldBlock block = {INFINITY, -INFINITY};
+                for (int cz = 2 * z; cz < 2 * z + 2 && cz < belowHeight; cz++)
+                {
+                    for (int cx = 2 * x; cx < 2 * x + 2 && cx < belowWidth; cx++)
+                    {
+                        HeightfieldBlock child = GetBlock(heightfield, (int)i, cx, cz);
+                        block.min = fminf(block.min, child.min);
+                        block.max = fmaxf(block.max, child.max);
+                    }
+                }
+                level->blocks[z * level->width + x] = block;
+            }
+        }
+        heightfield->levels_size++;
+        belowWidth = level->width;
+        belowHeight = level->height;
+    }
+}
+
+/**
+ * @brief Clip the ray to the bounds, narrowing [tMin, tMax]
+ * @return false if the ray misses them
+ */
+static bool ClipRay(AABB bounds, V3 origin, V3 direction, float *tMin, float *tMax)
+{
+    const float o[3] = {origin.x, origin.y, origin.z};
+    const float d[3] = {direction.x, direction.y, direction.z};
+    const float lo[3] = {bounds.min.x, bounds.min.y, bounds.min.z};
+    const float hi[3] = {bounds.max.x, bounds.max.y, bounds.max.z};
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (d[axis] == 0.0f)
+        {
+            if (o[axis] < lo[axis] || o[axis] > hi[axis])
+                return false;
+            continue;
+        }
+        float t0 = (lo[axis] - o[axis]) / d[axis];
+        float t1 = (hi[axis] - o[axis]) / d[axis];
+        *tMin = fmaxf(*tMin, fminf(t0, t1));
+        *tMax = fminf(*tMax, fmaxf(t0, t1));
+    }
+    return *tMin <= *tMax;
+}
+
+/**
+ * @brief Distance at which the ray leaves a block along one axis
+ * @param size Cells per block on this level
+ */
+static inline float AxisExit(float origin, float direction, float gridOrigin, float spacing, int block, int size, int cells)
+{
+    if (direction > 0.0f)
+    {
+        int edge = (block + 1) * size < cells ? (block + 1) * size : cells;
+        return (edge * spacing + gridOrigin - origin) / direction;
+    }
+    if (direction < 0.0f)
+        return (block * size * spacing + gridOrigin - origin) / direction;
+    return INFINITY;
+}
+
+/// @brief Cell containing a coordinate along one axis, clamped to the grid
+static inline int AxisCell(float position, float gridOrigin, float spacing, int cells)
+{
+    float cell = floorf((position - gridOrigin) / spacing);
+    if (!(cell > 0.0f))
+        return 0;
+    if (cell > (float)(cells - 1))
+        return cells - 1;
+    return (int)cell;
+}
+
+/**
+ * @brief Möller-Trumbore, with the winding and normal of the triangles Noise_CreateMesh emits
+ * @note The barycentric bounds are widened a little so that rays along a shared edge hit one of its triangles instead
+ * of slipping through the crack between them
+ */
+static bool RayIntersectsTriangle(V3 origin, V3 direction, V3 v0, V3 v1, V3 v2, float *outDistance, V3 *outNormal)
+{
+    const float EPSILON = 0.0000001f;
+    const float EDGE_EPSILON = 0.00001f;
+    V3 edge1 = V3_SUB(v1, v0);
+    V3 edge2 = V3_SUB(v2, v0);
+    V3 h = V3_CROSS(direction, edge2);
+    float a = V3_DOT(edge1, h);
+    if (fabsf(a) < EPSILON)
+        return false;
+    float f = 1.0f / a;
+    V3 s = V3_SUB(origin, v0);
+    float u = f * V3_DOT(s, h);
+    if (u < -EDGE_EPSILON || u > 1.0f + EDGE_EPSILON)
+        return false;
+    V3 q = V3_CROSS(s, edge1);
+    float v = f * V3_DOT(direction, q);
+    if (v < -EDGE_EPSILON || u + v > 1.0f + EDGE_EPSILON)
+        return false;
+    float t = f * V3_DOT(edge2, q);
+    if (t <= EPSILON)
+        return false;
+    *outDistance = t;
+    *outNormal = V3_NORM(V3_CROSS(edge1, edge2));
+    return true;
+}
+
+/// @brief Closest of the cell's two triangles, if it is nearer than maxDistance
+static bool RaycastCell(const Heightfield *heightfield, int x, int z, V3 origin, V3 direction, float maxDistance,
+                        float *outDistance, V3 *outNormal)
+{
+    V3 v00 = SamplePosition(heightfield, x, z);
+    V3 v10 = SamplePosition(heightfield, x + 1, z);
+    V3 v01 = SamplePosition(heightfield, x, z + 1);
+    V3 v11 = SamplePosition(heightfield, x + 1, z + 1);
+    bool hit = false;
+    float distance;
+    V3 normal;
+    if (RayIntersectsTriangle(origin, direction, v00, v10, v01, &distance, &normal) && distance < maxDistance)
+    {
+        maxDistance = distance;
+        *outDistance = distance;
+        *outNormal = normal;
+        hit = true;
+    }
+    if (RayIntersectsTriangle(origin, direction, v01, v10, v11, &distance, &normal) && distance < maxDistance)
+    {
+        *outDistance = distance;
+        *outNormal = normal;
+        hit = true;
+    }
+    return hit;
+}
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+Heightfield *Heightfield_Create(float *const *map, int width, int height, V3 origin, V3 spacing)
+{
+    Heightfield *heightfield = malloc(sizeof(Heightfield));
+    memset(heightfield, 0, sizeof(Heightfield));
+    heightfield->origin = origin;
+    heightfield->spacing = spacing;
+    Heightfield_Update(heightfield, map, width, height);
+    LogCreate(&_logConfig, "%dx%d samples, %zu levels", width, height, heightfield->levels_size);
+    return heightfield;
+}
+
+void Heightfield_Free(Heightfield *heightfield)
+{
+    if (!heightfield)
+        return;
+    FreeLevels(heightfield);
+    free(heightfield);
+    LogFree(&_logConfig, "");
+}
+
+void Heightfield_Update(Heightfield *heightfield, float *const *map, int width, int height)
+{
+    FreeLevels(heightfield);
+    heightfield->map = map;
+    heightfield->width = width;
+    heightfield->height = height;
+    if (width < 2 || height < 2)
+    {
+        LogWarning(&_logConfig, "%dx%d samples do not form a single cell, nothing can hit it", width, height);
+        heightfield->bounds = (AABB){heightfield->origin, heightfield->origin};
+        return;
+    }
+    BuildLevels(heightfield);
+    HeightfieldBlock root = heightfield->levels[heightfield->levels_size - 1].blocks[0];
+    heightfield->bounds.min = (V3){heightfield->origin.x, root.min, heightfield->origin.z};
+    heightfield->bounds.max = (V3){
+        (width - 1) * heightfield->spacing.x + heightfield->origin.x,
+        root.max,
+        (height - 1) * heightfield->spacing.z + heightfield->origin.z};
+}
+
+// -------------------------
+// Queries
+// -------------------------
+
+bool Heightfield_GetHeight(const Heightfield *heightfield, float x, float z, float *outHeight)
+{
+    int cellsX = heightfield->width - 1;
+    int cellsZ = heightfield->height - 1;
+    if (cellsX < 1 || cellsZ < 1)
+        return false;
+    float fx = (x - heightfield->origin.x) / heightfield->spacing.x;
+    float fz = (z - heightfield->origin.z) / heightfield->spacing.z;
+    if (!(fx >= 0.0f && fx <= (float)cellsX && fz >= 0.0f && fz <= (float)cellsZ))
+        return false;
+    int cx = AxisCell(x, heightfield->origin.x, heightfield->spacing.x, cellsX);
+    int cz = AxisCell(z, heightfield->origin.z, heightfield->spacing.z, cellsZ);
+    float u = fx - cx, v = fz - cz;
+    float h10 = SampleHeight(heightfield, cx + 1, cz);
+    float h01 = SampleHeight(heightfield, cx, cz + 1);
+    if (u + v <= 1.0f)
+    {
+        float h00 = SampleHeight(heightfield, cx, cz);
+        *outHeight = h00 + u * (h10 - h00) + v * (h01 - h00);
+    }
+    else
+    {
+        float h11 = SampleHeight(heightfield, cx + 1, cz + 1);
+        *outHeight = h11 + (1.0f - u) * (h01 - h11) + (1.0f - v) * (h10 - h11);
+    }
+    return true;
+}
+
+bool Heightfield_Raycast(const Heightfield *heightfield, V3 origin, V3 direction, float maxDistance,
+                         float *outDistance, V3 *outNormal)
+{
+    if (heightfield->levels_size == 0)
+        return false;
+    float t = 0.0f, tMax = maxDistance;
+    if (!ClipRay(heightfield->bounds, origin, direction, &t, &tMax))
+        return false;
+
+    const int cellsX = heightfield->width - 1;
+    const int cellsZ = heightfield->height - 1;
+    const int top = (int)heightfield->levels_size;
+    const float epsilon = (heightfield->bounds.max.y - heightfield->bounds.min.y + 1.0f) * 1e-5f;
+    const V3 gridOrigin = heightfield->origin;
+    const V3 spacing = heightfield->spacing;
+    const int stepX = direction.x > 0.0f ? 1 : -1;
+    const int stepZ = direction.z > 0.0f ? 1 : -1;
+
+    int level = top;
+    while (true)
+    {
+        int size = 1 << level;
+        int blocksX = level > 0 ? heightfield->levels[level - 1].width : cellsX;
+        int blocksZ = level > 0 ? heightfield->levels[level - 1].height : cellsZ;
+
+        // Block under the ray at t, stepped forward when t sits on its exit edge
+        float px = origin.x + direction.x * t;
+        float pz = origin.z + direction.z * t;
+        int bx = AxisCell(px, gridOrigin.x, spacing.x, cellsX) >> level;
+        int bz = AxisCell(pz, gridOrigin.z, spacing.z, cellsZ) >> level;
+        float exitX = AxisExit(origin.x, direction.x, gridOrigin.x, spacing.x, bx, size, cellsX);
+        while (exitX <= t)
+        {
+            bx += stepX;
+            if (bx < 0 || bx >= blocksX)
+                return false;
+            exitX = AxisExit(origin.x, direction.x, gridOrigin.x, spacing.x, bx, size, cellsX);
+        }
+        float exitZ = AxisExit(origin.z, direction.z, gridOrigin.z, spacing.z, bz, size, cellsZ);
+        while (exitZ <= t)
+        {
+            bz += stepZ;
+            if (bz < 0 || bz >= blocksZ)
+                return false;
+            exitZ = AxisExit(origin.z, direction.z, gridOrigin.z, spacing.z, bz, size, cellsZ);
+        }
+        float tExit = fminf(fminf(exitX, exitZ), tMax);
+
+        // Skip the block when the ray stays above or below it while crossing
+        HeightfieldBlock block = GetBlock(heightfield, level, bx, bz);
+        float y0 = origin.y + direction.y * t;
+        float y1 = origin.y + direction.y * tExit;
+        bool overlaps = fmaxf(y0, y1) >= block.min - epsilon && fminf(y0, y1) <= block.max + epsilon;
+        if (overlaps && level > 0)
+        {
+            level--;
+            continue;
+        }
+        if (overlaps && RaycastCell(heightfield, bx, bz, origin, direction, maxDistance, outDistance, outNormal))
+            return true;
+
+        // Move on, the parent level may skip what is left of its block in one step
+        if (tExit >= tMax)
+            return false;
+        t = tExit;
+        if (level < top)
+            level++;
+    }
+}
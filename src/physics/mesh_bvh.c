@@ -1,5 +1,9 @@
 #include "physics/mesh_bvh.h"
+#include "physics/mesh_bvh_wide.h"
 #include "logging/logger.h"
+#include "utilities/file/file.h"
+#include "utilities/thread/task_pool.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
@@ -11,14 +15,31 @@
 
 static LogConfig _logConfig = {"MeshBVH", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
 
+_Static_assert(sizeof(BVHNode) == 32, "BVHNode should fit two per cache line");
+
+#define MESH_BVH_CACHE_MAGIC "MBVH"
+#define MESH_BVH_CACHE_VERSION 2
+
 // -------------------------
 // Helper Functions
 // -------------------------
 
+/**
+ * @brief Build-only data of a triangle, discarded once the tree is built
+ */
+typedef struct
+{
+    V3 min;
+    V3 max;
+    V3 centroid;
+    /// @brief Index of the triangle in the mesh
+    uint32_t source;
+} BVHBuildTriangle;
+
 /**
  * @brief Calculate AABB for a set of triangles
  */
-static AABB CalculateTriangleAABB(BVHTriangle *triangles, uint32_t count)
+static AABB CalculateTriangleAABB(BVHBuildTriangle *triangles, uint32_t count)
 {
     if (count == 0)
     {
@@ -26,160 +47,329 @@ static AABB CalculateTriangleAABB(BVHTriangle *triangles, uint32_t count)
         return empty;
     }
     
-    AABB result = triangles[0].bounds;
+    AABB result = {triangles[0].min, triangles[0].max};
     
     for (uint32_t i = 1; i < count; i++)
     {
-        AABB tri_bounds = triangles[i].bounds;
-        
         // Expand to include this triangle
-        if (tri_bounds.min.x < result.min.x) result.min.x = tri_bounds.min.x;
-        if (tri_bounds.min.y < result.min.y) result.min.y = tri_bounds.min.y;
-        if (tri_bounds.min.z < result.min.z) result.min.z = tri_bounds.min.z;
+        if (triangles[i].min.x < result.min.x) result.min.x = triangles[i].min.x;
+        if (triangles[i].min.y < result.min.y) result.min.y = triangles[i].min.y;
+        if (triangles[i].min.z < result.min.z) result.min.z = triangles[i].min.z;
         
-        if (tri_bounds.max.x > result.max.x) result.max.x = tri_bounds.max.x;
-        if (tri_bounds.max.y > result.max.y) result.max.y = tri_bounds.max.y;
-        if (tri_bounds.max.z > result.max.z) result.max.z = tri_bounds.max.z;
+        if (triangles[i].max.x > result.max.x) result.max.x = triangles[i].max.x;
+        if (triangles[i].max.y > result.max.y) result.max.y = triangles[i].max.y;
+        if (triangles[i].max.z > result.max.z) result.max.z = triangles[i].max.z;
     }
     
     return result;
 }
 
+inline static float AxisOf(V3 v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+inline static float SurfaceArea(AABB bounds)
+{
+    V3 d = V3_SUB(bounds.max, bounds.min);
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+inline static void GrowAABB(AABB *bounds, AABB other)
+{
+    bounds->min = V3_MIN(bounds->min, other.min);
+    bounds->max = V3_MAX(bounds->max, other.max);
+}
+
 /**
- * @brief Comparison function for sorting triangles by centroid
+ * @brief One bin of the SAH sweep: triangles whose centroid falls in it and their bounds
  */
-static int CompareTrianglesCentroid(void *axis_ptr, const void *a, const void *b)
+typedef struct
 {
-    int axis = *(int*)axis_ptr;
-    const BVHTriangle *tri_a = (const BVHTriangle*)a;
-    const BVHTriangle *tri_b = (const BVHTriangle*)b;
-    
-    float val_a, val_b;
-    switch (axis)
+    AABB bounds;
+    uint32_t count;
+} SAHBin;
+
+typedef struct
+{
+    MeshBVHBuildSettings settings;
+    // Output, sized for the worst case of 2n - 1 nodes
+    BVHNode *nodes;
+    uint32_t node_count;
+    /// @brief Start of the whole triangle array, leaves store offsets from it
+    BVHBuildTriangle *triangles;
+    // Statistics
+    uint32_t total_nodes;
+    uint32_t leaf_nodes;
+    uint32_t max_depth;
+} BuildContext;
+
+/**
+ * @brief Find the cheapest binned SAH split of the triangles
+ * @return Cost of the split relative to the node's surface area, FLT_MAX if the centroids cannot be separated
+ */
+static float FindSAHSplit(BuildContext *ctx, BVHBuildTriangle *triangles, uint32_t count, AABB centroid_bounds,
+                          int *out_axis, float *out_split)
+{
+    SAHBin bins[MESH_BVH_MAX_BINS];
+    float right_area[MESH_BVH_MAX_BINS];
+    uint32_t right_count[MESH_BVH_MAX_BINS];
+    uint32_t bin_count = ctx->settings.bin_count;
+    float best_cost = FLT_MAX;
+
+    V3 extent = V3_SUB(centroid_bounds.max, centroid_bounds.min);
+    int first_axis = 0, last_axis = 2;
+    if (ctx->settings.quality == MESH_BVH_QUALITY_FAST)
     {
-        case 0: val_a = tri_a->centroid.x; val_b = tri_b->centroid.x; break;
-        case 1: val_a = tri_a->centroid.y; val_b = tri_b->centroid.y; break;
-        case 2: val_a = tri_a->centroid.z; val_b = tri_b->centroid.z; break;
-        default: return 0;
+        // Only try the axis along which centroids are most spread out
+        first_axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+        last_axis = first_axis;
     }
-    
-    if (val_a < val_b) return -1;
-    if (val_a > val_b) return 1;
-    return 0;
+
+    for (int axis = first_axis; axis <= last_axis; axis++)
+    {
+        float axis_min = AxisOf(centroid_bounds.min, axis);
+        float axis_extent = AxisOf(extent, axis);
+        if (axis_extent <= 0.0f)
+            continue;
+        float scale = bin_count / axis_extent;
+
+        for (uint32_t b = 0; b < bin_count; b++)
+        {
+            bins[b].bounds = (AABB){{FLT_MAX, FLT_MAX, FLT_MAX}, {-FLT_MAX, -FLT_MAX, -FLT_MAX}};
+            bins[b].count = 0;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t b = (uint32_t)((AxisOf(triangles[i].centroid, axis) - axis_min) * scale);
+            if (b >= bin_count)
+                b = bin_count - 1;
+            bins[b].count++;
+            GrowAABB(&bins[b].bounds, (AABB){triangles[i].min, triangles[i].max});
+        }
+
+        // Sweep from the right to get the area and count on the right of each plane
+        AABB accumulated = bins[bin_count - 1].bounds;
+        uint32_t accumulated_count = 0;
+        for (uint32_t b = bin_count - 1; b > 0; b--)
+        {
+            if (bins[b].count > 0)
+                GrowAABB(&accumulated, bins[b].bounds);
+            accumulated_count += bins[b].count;
+            right_area[b] = accumulated_count > 0 ? SurfaceArea(accumulated) : 0.0f;
+            right_count[b] = accumulated_count;
+        }
+
+        // Sweep from the left and evaluate every plane
+        accumulated = bins[0].bounds;
+        accumulated_count = 0;
+        for (uint32_t b = 0; b < bin_count - 1; b++)
+        {
+            if (bins[b].count > 0)
+                GrowAABB(&accumulated, bins[b].bounds);
+            accumulated_count += bins[b].count;
+            if (accumulated_count == 0 || right_count[b + 1] == 0)
+                continue;
+            float cost = SurfaceArea(accumulated) * accumulated_count + right_area[b + 1] * right_count[b + 1];
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                *out_axis = axis;
+                *out_split = axis_min + (b + 1) / scale;
+            }
+        }
+    }
+    return best_cost;
 }
 
 /**
- * @brief Sort triangles by centroid along specified axis
+ * @brief Compute a node's bounds and decide how to split it. Partitions the triangles in place when splitting.
+ * @param out_mid Number of triangles going to the left child
+ * @return true if the node should be a leaf
  */
-static void SortTriangles(BVHTriangle *triangles, uint32_t count, int axis)
+static bool SplitNode(BuildContext *ctx, BVHBuildTriangle *triangles, uint32_t count, uint32_t depth, BVHNode *node, uint32_t *out_mid)
 {
-    // Use a simple insertion sort for small arrays, qsort for larger ones
-    if (count <= 16)
+    // Calculate bounding box for this node
+    AABB bounds = CalculateTriangleAABB(triangles, count);
+    node->min = bounds.min;
+    node->max = bounds.max;
+    float area = SurfaceArea(bounds);
+
+    // Evaluate the best split against keeping every triangle in a leaf
+    int split_axis = 0;
+    float split_position = 0.0f;
+    float split_cost = FLT_MAX;
+    float leaf_cost = ctx->settings.intersection_cost * count;
+    if (count > 1 && depth < MESH_BVH_MAX_DEPTH)
     {
-        // Insertion sort
+        AABB centroid_bounds = {triangles[0].centroid, triangles[0].centroid};
         for (uint32_t i = 1; i < count; i++)
         {
-            BVHTriangle key = triangles[i];
-            int j = i - 1;
-            
-            float key_val, cmp_val;
-            switch (axis)
+            centroid_bounds.min = V3_MIN(centroid_bounds.min, triangles[i].centroid);
+            centroid_bounds.max = V3_MAX(centroid_bounds.max, triangles[i].centroid);
+        }
+        float cost = FindSAHSplit(ctx, triangles, count, centroid_bounds, &split_axis, &split_position);
+        if (cost < FLT_MAX)
+        {
+            split_cost = ctx->settings.traversal_cost + ctx->settings.intersection_cost * (area > 0.0f ? cost / area : count);
+        }
+    }
+
+    bool make_leaf = count <= 1 || depth >= MESH_BVH_MAX_DEPTH ||
+                     (count <= ctx->settings.max_triangles_per_leaf && split_cost >= leaf_cost);
+    if (make_leaf)
+        return true;
+
+    uint32_t mid = 0;
+    if (split_cost < FLT_MAX)
+    {
+        // O(n) partition around the chosen plane
+        uint32_t left = 0, right = count;
+        while (left < right)
+        {
+            if (AxisOf(triangles[left].centroid, split_axis) < split_position)
             {
-                case 0: key_val = key.centroid.x; break;
-                case 1: key_val = key.centroid.y; break;
-                case 2: key_val = key.centroid.z; break;
-                default: continue;
+                left++;
             }
-            
-            while (j >= 0)
+            else
             {
-                switch (axis)
-                {
-                    case 0: cmp_val = triangles[j].centroid.x; break;
-                    case 1: cmp_val = triangles[j].centroid.y; break;
-                    case 2: cmp_val = triangles[j].centroid.z; break;
-                    default: cmp_val = 0; break;
-                }
-                
-                if (cmp_val <= key_val) break;
-                
-                triangles[j + 1] = triangles[j];
-                j--;
+                BVHBuildTriangle tmp = triangles[left];
+                triangles[left] = triangles[--right];
+                triangles[right] = tmp;
             }
-            triangles[j + 1] = key;
         }
+        mid = left;
     }
-    else
+    // All centroids coincide, or floating point put everything on one side - split by count
+    if (mid == 0 || mid == count)
+        mid = count / 2;
+    *out_mid = mid;
+    return false;
+}
+
+inline static void MakeLeaf(BuildContext *ctx, BVHNode *node, BVHBuildTriangle *triangles, uint32_t count)
+{
+    node->offset = (uint32_t)(triangles - ctx->triangles);
+    node->count = count;
+    ctx->leaf_nodes++;
+}
+
+/**
+ * @brief Build BVH node recursively in depth-first order: the left child directly follows its parent.
+ * Triangles are partitioned in place and leaves reference a range of the array.
+ * @return Index of the node
+ */
+static uint32_t BuildBVHNode(BuildContext *ctx, BVHBuildTriangle *triangles, uint32_t count, uint32_t depth)
+{
+    ctx->total_nodes++;
+    if (depth > ctx->max_depth)
+        ctx->max_depth = depth;
+
+    uint32_t index = ctx->node_count++;
+    uint32_t mid;
+    if (SplitNode(ctx, triangles, count, depth, &ctx->nodes[index], &mid))
     {
-        // For larger arrays, use qsort_r (Windows/MSVC compatible)
-        #ifdef _WIN32
-        qsort_s(triangles, count, sizeof(BVHTriangle), CompareTrianglesCentroid, &axis);
-        #else
-        qsort_r(triangles, count, sizeof(BVHTriangle), CompareTrianglesCentroid, &axis);
-        #endif
+        MakeLeaf(ctx, &ctx->nodes[index], triangles, count);
+        return index;
     }
+
+    BuildBVHNode(ctx, triangles, mid, depth + 1);
+    uint32_t right = BuildBVHNode(ctx, triangles + mid, count - mid, depth + 1);
+    BVHNode *node = &ctx->nodes[index];
+    node->offset = right - index;
+    node->count = 0;
+    return index;
 }
 
+// -------------------------
+// Parallel Build
+// -------------------------
+
 /**
- * @brief Find best split axis for BVH construction
+ * @brief A subtree built into its own node array. Internal nodes only store relative offsets,
+ * so the arrays of both children can be appended after their parent as they are.
  */
-static int FindBestSplitAxis(AABB bounds)
+typedef struct
 {
-    V3 extent = V3_SUB(bounds.max, bounds.min);
-    
-    if (extent.x >= extent.y && extent.x >= extent.z)
-        return 0; // X axis
-    else if (extent.y >= extent.z)
-        return 1; // Y axis
-    else
-        return 2; // Z axis
+    BuildContext ctx;
+    TaskPool *pool;
+    BVHBuildTriangle *triangles;
+    uint32_t count;
+    uint32_t depth;
+} SubtreeBuild;
+
+static void BuildSubtree(void *data)
+{
+    SubtreeBuild *build = data;
+    BuildContext *ctx = &build->ctx;
+    ctx->nodes = malloc(sizeof(BVHNode) * (2 * (size_t)build->count - 1));
+    if (build->count < MESH_BVH_PARALLEL_MIN_TRIANGLES || !build->pool || build->pool->workers_size == 0)
+    {
+        BuildBVHNode(ctx, build->triangles, build->count, build->depth);
+        return;
+    }
+
+    // Same decisions as BuildBVHNode, so both builders produce the same tree
+    ctx->total_nodes++;
+    if (build->depth > ctx->max_depth)
+        ctx->max_depth = build->depth;
+    ctx->node_count = 1;
+    uint32_t mid;
+    if (SplitNode(ctx, build->triangles, build->count, build->depth, &ctx->nodes[0], &mid))
+    {
+        MakeLeaf(ctx, &ctx->nodes[0], build->triangles, build->count);
+        return;
+    }
+
+    SubtreeBuild children[2];
+    for (int i = 0; i < 2; i++)
+    {
+        children[i] = (SubtreeBuild){
+            .ctx = {.settings = ctx->settings, .triangles = ctx->triangles},
+            .pool = build->pool,
+            .triangles = i == 0 ? build->triangles : build->triangles + mid,
+            .count = i == 0 ? mid : build->count - mid,
+            .depth = build->depth + 1};
+    }
+    // Left on another thread, right on this one
+    TaskGroup group = {0};
+    TaskPool_Submit(build->pool, &group, BuildSubtree, &children[0]);
+    BuildSubtree(&children[1]);
+    TaskPool_Wait(build->pool, &group);
+
+    // Depth-first order: node, left subtree, right subtree
+    for (int i = 0; i < 2; i++)
+    {
+        BuildContext *child = &children[i].ctx;
+        memcpy(&ctx->nodes[ctx->node_count], child->nodes, sizeof(BVHNode) * child->node_count);
+        ctx->node_count += child->node_count;
+        ctx->total_nodes += child->total_nodes;
+        ctx->leaf_nodes += child->leaf_nodes;
+        if (child->max_depth > ctx->max_depth)
+            ctx->max_depth = child->max_depth;
+        free(child->nodes);
+    }
+    ctx->nodes[0].offset = 1 + children[0].ctx.node_count;
+    ctx->nodes[0].count = 0;
 }
 
 /**
- * @brief Build BVH node recursively
+ * @brief Expected traversal cost of the tree according to the surface area heuristic, relative to the root.
+ * Summed in node order so every builder reports the exact same value for the same tree.
  */
-static BVHNode *BuildBVHNode(BVHTriangle *triangles, uint32_t count, 
-                             uint32_t max_triangles_per_leaf, uint32_t depth,
-                             uint32_t *total_nodes, uint32_t *leaf_nodes, uint32_t *max_depth)
+static float TreeCost(const MeshBVH *bvh)
 {
-    (*total_nodes)++;
-    if (depth > *max_depth)
-        *max_depth = depth;
-    
-    BVHNode *node = malloc(sizeof(BVHNode));
-    memset(node, 0, sizeof(BVHNode));
-    
-    // Calculate bounding box for this node
-    node->bounds = CalculateTriangleAABB(triangles, count);
-    
-    // Check if we should create a leaf
-    if (count <= max_triangles_per_leaf)
+    const BVHNode *root = &bvh->nodes[0];
+    float root_area = SurfaceArea((AABB){root->min, root->max});
+    float cost = 0.0f;
+    for (uint32_t i = 0; i < bvh->total_nodes; i++)
     {
-        // Create leaf node
-        node->is_leaf = true;
-        node->triangle_count = count;
-        node->triangles = malloc(sizeof(BVHTriangle) * count);
-        memcpy(node->triangles, triangles, sizeof(BVHTriangle) * count);
-        (*leaf_nodes)++;
-        return node;
+        const BVHNode *node = &bvh->nodes[i];
+        float relative_area = root_area > 0.0f ? SurfaceArea((AABB){node->min, node->max}) / root_area : 1.0f;
+        cost += relative_area * (node->count > 0 ? bvh->settings.intersection_cost * node->count
+                                                 : bvh->settings.traversal_cost);
     }
-    
-    // Create internal node - find best split
-    int split_axis = FindBestSplitAxis(node->bounds);
-    
-    // Sort triangles along split axis
-    SortTriangles(triangles, count, split_axis);
-    
-    // Split in the middle
-    uint32_t mid = count / 2;
-    
-    // Recursively build children
-    node->left = BuildBVHNode(triangles, mid, max_triangles_per_leaf, 
-                              depth + 1, total_nodes, leaf_nodes, max_depth);
-    node->right = BuildBVHNode(triangles + mid, count - mid, max_triangles_per_leaf,
-                               depth + 1, total_nodes, leaf_nodes, max_depth);
-    
-    return node;
+    return cost;
 }
 
 /**
@@ -229,104 +419,425 @@ static bool RayIntersectsTriangle(V3 rayOrigin, V3 rayDir,
 }
 
 /**
- * @brief Ray-AABB intersection test
+ * @brief Ray-AABB slab test against a node
+ * @param t_enter Distance at which the ray enters the node, valid when true is returned
  */
-static bool RayIntersectsAABB(V3 origin, V3 direction, AABB aabb, float max_distance)
+inline static bool RayIntersectsNode(V3 origin, V3 inv_dir, const BVHNode *node, float max_distance, float *t_enter)
 {
-    V3 invDir = {
-        (fabsf(direction.x) > 0.0001f) ? 1.0f / direction.x : FLT_MAX,
-        (fabsf(direction.y) > 0.0001f) ? 1.0f / direction.y : FLT_MAX,
-        (fabsf(direction.z) > 0.0001f) ? 1.0f / direction.z : FLT_MAX
-    };
-
-    float t1 = (aabb.min.x - origin.x) * invDir.x;
-    float t2 = (aabb.max.x - origin.x) * invDir.x;
-    float t3 = (aabb.min.y - origin.y) * invDir.y;
-    float t4 = (aabb.max.y - origin.y) * invDir.y;
-    float t5 = (aabb.min.z - origin.z) * invDir.z;
-    float t6 = (aabb.max.z - origin.z) * invDir.z;
+    float t1 = (node->min.x - origin.x) * inv_dir.x;
+    float t2 = (node->max.x - origin.x) * inv_dir.x;
+    float t3 = (node->min.y - origin.y) * inv_dir.y;
+    float t4 = (node->max.y - origin.y) * inv_dir.y;
+    float t5 = (node->min.z - origin.z) * inv_dir.z;
+    float t6 = (node->max.z - origin.z) * inv_dir.z;
 
     float tmin = fmaxf(fmaxf(fminf(t1, t2), fminf(t3, t4)), fminf(t5, t6));
     float tmax = fminf(fminf(fmaxf(t1, t2), fmaxf(t3, t4)), fmaxf(t5, t6));
 
+    *t_enter = tmin;
     return (tmax >= tmin && tmax >= 0.0f && tmin <= max_distance);
 }
 
 /**
- * @brief Recursive BVH traversal for raycast
+ * @brief Iterative BVH traversal for raycast, nearer child first
  */
-static bool TraverseBVH(BVHNode *node, V3 origin, V3 direction, float max_distance, BVHRaycastHit *best_hit)
+static bool TraverseBVH(MeshBVH *bvh, V3 origin, V3 direction, BVHRaycastHit *best_hit)
 {
-    if (!node)
-        return false;
-    
-    // Early rejection - test ray against node bounds
-    if (!RayIntersectsAABB(origin, direction, node->bounds, max_distance))
+    // Directions are not normalized (local space of scaled meshes), only a zero component is degenerate
+    V3 inv_dir = {
+        (direction.x != 0.0f) ? 1.0f / direction.x : FLT_MAX,
+        (direction.y != 0.0f) ? 1.0f / direction.y : FLT_MAX,
+        (direction.z != 0.0f) ? 1.0f / direction.z : FLT_MAX
+    };
+
+    float t_enter;
+    if (!RayIntersectsNode(origin, inv_dir, &bvh->nodes[0], best_hit->distance, &t_enter))
         return false;
-    
-    if (node->is_leaf)
+
+    uint32_t stack[MESH_BVH_STACK_SIZE];
+    float stack_enter[MESH_BVH_STACK_SIZE];
+    int stack_size = 0;
+    uint32_t index = 0;
+    bool hit_any = false;
+
+    while (true)
     {
-        // Test ray against all triangles in leaf
-        bool hit_any = false;
-        
-        for (uint32_t i = 0; i < node->triangle_count; i++)
+        const BVHNode *node = &bvh->nodes[index];
+        if (node->count > 0)
         {
-            BVHTriangle *triangle = &node->triangles[i];
-            
-            float distance;
-            V3 normal;
-            if (RayIntersectsTriangle(origin, direction, 
-                                      triangle->vertices[0], triangle->vertices[1], triangle->vertices[2],
-                                      &distance, &normal))
+            // Test ray against all triangles in leaf
+            for (uint32_t i = node->offset; i < node->offset + node->count; i++)
             {
-                if (distance < best_hit->distance)
+                V3 vertices[3];
+                MeshBVH_GetTriangle(bvh, bvh->triangles[i], vertices);
+                float distance;
+                V3 normal;
+                if (RayIntersectsTriangle(origin, direction, vertices[0], vertices[1], vertices[2], &distance, &normal) &&
+                    distance < best_hit->distance)
                 {
                     best_hit->hit = true;
                     best_hit->distance = distance;
                     best_hit->point = V3_ADD(origin, V3_SCALE(direction, distance));
                     best_hit->normal = normal;
-                    best_hit->triangle = triangle;
-                    best_hit->triangle_index = i; // Note: This is local to the leaf
+                    best_hit->triangle_index = bvh->triangles[i];
                     hit_any = true;
                 }
             }
         }
-        
-        return hit_any;
+        else
+        {
+            uint32_t left = index + 1;
+            uint32_t right = index + node->offset;
+            float t_left, t_right;
+            bool hit_left = RayIntersectsNode(origin, inv_dir, &bvh->nodes[left], best_hit->distance, &t_left);
+            bool hit_right = RayIntersectsNode(origin, inv_dir, &bvh->nodes[right], best_hit->distance, &t_right);
+            if (hit_left && hit_right)
+            {
+                // Visit the nearer child now, come back to the other one later
+                bool left_first = t_left <= t_right;
+                stack[stack_size] = left_first ? right : left;
+                stack_enter[stack_size++] = left_first ? t_right : t_left;
+                index = left_first ? left : right;
+                continue;
+            }
+            if (hit_left || hit_right)
+            {
+                index = hit_left ? left : right;
+                continue;
+            }
+        }
+
+        // Pop the next node the ray may still reach before the closest hit
+        do
+        {
+            if (stack_size == 0)
+                return hit_any;
+            stack_size--;
+        } while (stack_enter[stack_size] > best_hit->distance);
+        index = stack[stack_size];
+    }
+}
+
+/**
+ * @brief Number of triangles the mesh currently describes
+ */
+static uint32_t MeshTriangleCount(const Mesh *mesh)
+{
+    if (mesh->indices && mesh->indices_size > 0)
+        return mesh->indices_size / 3;
+    return mesh->vertices_size / 3;
+}
+
+/**
+ * @brief Bounds and centroid of the mesh's i-th triangle, for the builder
+ */
+static void LoadBuildTriangle(BVHBuildTriangle *tri, const MeshBVH *bvh, uint32_t i)
+{
+    V3 vertices[3];
+    MeshBVH_GetTriangle(bvh, i, vertices);
+    tri->source = i;
+    tri->min = V3_MIN(V3_MIN(vertices[0], vertices[1]), vertices[2]);
+    tri->max = V3_MAX(V3_MAX(vertices[0], vertices[1]), vertices[2]);
+    tri->centroid = V3_SCALE(V3_ADD(V3_ADD(vertices[0], vertices[1]), vertices[2]), 1.0f / 3.0f);
+}
+
+/**
+ * @brief Build the triangle list and the tree from scratch, bvh->settings must be set
+ */
+static void BuildTree(MeshBVH *bvh, uint32_t triangle_count)
+{
+    bvh->triangle_count = triangle_count;
+    BVHBuildTriangle *triangles = malloc(sizeof(BVHBuildTriangle) * triangle_count);
+    for (uint32_t i = 0; i < triangle_count; i++)
+    {
+        LoadBuildTriangle(&triangles[i], bvh, i);
+    }
+    
+    // Build BVH tree
+    SubtreeBuild root = {
+        .ctx = {.settings = bvh->settings, .triangles = triangles},
+        .pool = TaskPool_Get(),
+        .triangles = triangles,
+        .count = triangle_count,
+        .depth = 0};
+    BuildSubtree(&root);
+
+    // Only the order of the triangles is kept, positions stay in the mesh
+    bvh->triangles = malloc(sizeof(uint32_t) * triangle_count);
+    for (uint32_t i = 0; i < triangle_count; i++)
+    {
+        bvh->triangles[i] = triangles[i].source;
+    }
+    free(triangles);
+    // Give back the worst-case reservation
+    bvh->nodes = realloc(root.ctx.nodes, sizeof(BVHNode) * root.ctx.node_count);
+    bvh->total_nodes = root.ctx.total_nodes;
+    bvh->leaf_nodes = root.ctx.leaf_nodes;
+    bvh->max_depth = root.ctx.max_depth;
+    bvh->sah_cost = TreeCost(bvh);
+    bvh->build_sah_cost = bvh->sah_cost;
+
+    bvh->wide = MeshBVHWide_Create(bvh);
+}
+
+static void FreeVertexTriangles(MeshBVH *bvh)
+{
+    free(bvh->vertex_triangle_offsets);
+    free(bvh->vertex_triangles);
+    bvh->vertex_triangle_offsets = NULL;
+    bvh->vertex_triangles = NULL;
+    bvh->vertex_count = 0;
+}
+
+/**
+ * @brief Release everything BuildTree, LoadCache and refits allocated
+ */
+static void FreeTree(MeshBVH *bvh)
+{
+    MeshBVHWide_Free(bvh->wide);
+    if (bvh->cache_mapping)
+    {
+        File_Unmap(bvh->cache_mapping, bvh->cache_mapping_size);
     }
     else
     {
-        // Internal node - traverse children
-        bool hit_left = TraverseBVH(node->left, origin, direction, best_hit->distance, best_hit);
-        bool hit_right = TraverseBVH(node->right, origin, direction, best_hit->distance, best_hit);
-        
-        return hit_left || hit_right;
+        free(bvh->nodes);
+        free(bvh->triangles);
     }
+    FreeVertexTriangles(bvh);
+    free(bvh->triangle_leaves);
+    free(bvh->dirty_nodes);
+    bvh->triangle_leaves = NULL;
+    bvh->dirty_nodes = NULL;
+    bvh->wide = NULL;
+    bvh->nodes = NULL;
+    bvh->cache_mapping = NULL;
+    bvh->cache_mapping_size = 0;
+    bvh->triangles = NULL;
 }
 
 // -------------------------
-// Public Functions
+// Cache
 // -------------------------
 
-MeshBVH *MeshBVH_Create(Mesh *mesh, uint32_t max_triangles_per_leaf)
+/**
+ * @brief Start of a cache file. Followed by total_nodes BVHNode, then MeshBVH::triangles.
+ */
+typedef struct
 {
-    if (!mesh || !mesh->vertices)
+    char magic[4];
+    uint32_t version;
+    uint64_t hash;
+    MeshBVHBuildSettings settings;
+    uint32_t triangle_count;
+    uint32_t total_nodes;
+    uint32_t leaf_nodes;
+    uint32_t max_depth;
+    float sah_cost;
+    /// @brief sizeof(BVHNode) of the writer, rejects files from builds with another layout
+    uint32_t node_size;
+} MeshBVHCacheHeader;
+
+inline static uint64_t HashBytes(uint64_t hash, const void *data, size_t size)
+{
+    // FNV-1a
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < size; i++)
     {
-        LogError(&_logConfig, "Invalid mesh provided to MeshBVH_Create");
-        return NULL;
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
     }
-    
-    // Calculate triangle count
-    uint32_t triangle_count;
+    return hash;
+}
+
+/**
+ * @brief Hash everything the tree depends on: vertex positions, indices and build settings
+ */
+static uint64_t HashMesh(const Mesh *mesh, MeshBVHBuildSettings settings)
+{
+    uint64_t hash = 14695981039346656037ull;
+    hash = HashBytes(hash, &settings, sizeof(settings));
+    for (size_t i = 0; i < mesh->vertices_size; i++)
+        hash = HashBytes(hash, &mesh->vertices[i].position, sizeof(V3));
     if (mesh->indices && mesh->indices_size > 0)
+        hash = HashBytes(hash, mesh->indices, sizeof(uint32_t) * mesh->indices_size);
+    return hash;
+}
+
+static void CachePath(char *path, size_t path_size, uint64_t hash)
+{
+    snprintf(path, path_size, "%s/mesh_bvh_%016llx.bin", MESH_BVH_CACHE_DIR, (unsigned long long)hash);
+}
+
+/**
+ * @brief Walk a cached tree once, as traversal would, before trusting it: children must lie after their parent and
+ * inside the array, leaves inside the triangle order, and the depth within the fixed traversal stacks
+ */
+static bool ValidateNodes(const BVHNode *nodes, uint32_t total_nodes, uint32_t triangle_count)
+{
+    uint32_t stack[MESH_BVH_STACK_SIZE];
+    uint32_t stack_depth[MESH_BVH_STACK_SIZE];
+    int stack_size = 0;
+    uint32_t index = 0;
+    uint32_t depth = 0;
+    // A valid tree visits every node once, shared children would make the walk blow up
+    uint32_t visited = 0;
+    while (true)
     {
-        triangle_count = mesh->indices_size / 3;
+        if (++visited > total_nodes)
+            return false;
+        const BVHNode *node = &nodes[index];
+        if (node->count > 0)
+        {
+            if ((uint64_t)node->offset + node->count > triangle_count)
+                return false;
+            if (stack_size == 0)
+                return true;
+            stack_size--;
+            index = stack[stack_size];
+            depth = stack_depth[stack_size];
+            continue;
+        }
+        // The right child comes after the whole left subtree, at least one node after the left child
+        if (node->offset < 2 || (uint64_t)index + node->offset >= total_nodes || depth >= MESH_BVH_MAX_DEPTH)
+            return false;
+        stack[stack_size] = index + node->offset;
+        stack_depth[stack_size++] = depth + 1;
+        index++;
+        depth++;
     }
-    else
+}
+
+/**
+ * @brief Map a cached tree. Nodes and triangle order are used in place from the mapping.
+ * @return false if there is no valid cache for this hash
+ */
+static bool LoadCache(MeshBVH *bvh, uint32_t triangle_count, uint64_t hash)
+{
+    char path[256];
+    CachePath(path, sizeof(path), hash);
+    size_t size;
+    unsigned char *data = File_Map(path, &size);
+    if (!data)
+        return false;
+
+    const MeshBVHCacheHeader *header = (const MeshBVHCacheHeader *)data;
+    bool valid = size >= sizeof(MeshBVHCacheHeader) &&
+                 memcmp(header->magic, MESH_BVH_CACHE_MAGIC, 4) == 0 &&
+                 header->version == MESH_BVH_CACHE_VERSION &&
+                 header->hash == hash &&
+                 memcmp(&header->settings, &bvh->settings, sizeof(MeshBVHBuildSettings)) == 0 &&
+                 header->triangle_count == triangle_count &&
+                 header->node_size == sizeof(BVHNode) &&
+                 header->total_nodes > 0 &&
+                 header->max_depth <= MESH_BVH_MAX_DEPTH &&
+                 size == sizeof(MeshBVHCacheHeader) + sizeof(BVHNode) * (size_t)header->total_nodes +
+                             sizeof(uint32_t) * (size_t)triangle_count;
+    const uint32_t *sources = (const uint32_t *)(data + sizeof(MeshBVHCacheHeader) + sizeof(BVHNode) * (size_t)(valid ? header->total_nodes : 0));
+    for (uint32_t i = 0; valid && i < triangle_count; i++)
+        valid = sources[i] < triangle_count;
+    valid = valid && ValidateNodes((const BVHNode *)(data + sizeof(MeshBVHCacheHeader)), header->total_nodes, triangle_count);
+    if (!valid)
+    {
+        LogWarning(&_logConfig, "Ignoring stale or invalid cache %s", path);
+        File_Unmap(data, size);
+        return false;
+    }
+
+    bvh->cache_mapping = data;
+    bvh->cache_mapping_size = size;
+    bvh->nodes = (BVHNode *)(data + sizeof(MeshBVHCacheHeader));
+    bvh->total_nodes = header->total_nodes;
+    bvh->leaf_nodes = header->leaf_nodes;
+    bvh->max_depth = header->max_depth;
+    bvh->sah_cost = header->sah_cost;
+    bvh->build_sah_cost = header->sah_cost;
+    bvh->triangle_count = triangle_count;
+    bvh->triangles = (uint32_t *)sources;
+    bvh->wide = MeshBVHWide_Create(bvh);
+    LogSuccess(&_logConfig, "Loaded BVH from cache %s", path);
+    return true;
+}
+
+/**
+ * @brief Write the freshly built tree, through a temporary file so readers never see a partial cache
+ */
+static void WriteCache(const MeshBVH *bvh, uint64_t hash)
+{
+    if (!File_CreateDirectory(MESH_BVH_CACHE_DIR))
+        return;
+    char path[256], temp_path[264];
+    CachePath(path, sizeof(path), hash);
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+    FILE *file = fopen(temp_path, "wb");
+    if (!file)
+    {
+        LogWarning(&_logConfig, "Could not write cache %s", temp_path);
+        return;
+    }
+
+    MeshBVHCacheHeader header = {0};
+    memcpy(header.magic, MESH_BVH_CACHE_MAGIC, 4);
+    header.version = MESH_BVH_CACHE_VERSION;
+    header.hash = hash;
+    header.settings = bvh->settings;
+    header.triangle_count = bvh->triangle_count;
+    header.total_nodes = bvh->total_nodes;
+    header.leaf_nodes = bvh->leaf_nodes;
+    header.max_depth = bvh->max_depth;
+    header.sah_cost = bvh->sah_cost;
+    header.node_size = sizeof(BVHNode);
+
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(bvh->nodes, sizeof(BVHNode), bvh->total_nodes, file) == bvh->total_nodes &&
+                   fwrite(bvh->triangles, sizeof(uint32_t), bvh->triangle_count, file) == bvh->triangle_count;
+    written = fclose(file) == 0 && written;
+
+    // rename does not replace an existing file on Windows
+    remove(path);
+    if (!written || rename(temp_path, path) != 0)
+    {
+        LogWarning(&_logConfig, "Could not write cache %s", path);
+        remove(temp_path);
+        return;
+    }
+    Log(&_logConfig, "Wrote BVH cache %s", path);
+}
+
+// -------------------------
+// Public Functions
+// -------------------------
+
+MeshBVHBuildSettings MeshBVHBuildSettings_Default()
+{
+    return (MeshBVHBuildSettings){
+        .max_triangles_per_leaf = 8,
+        .bin_count = 16,
+        .quality = MESH_BVH_QUALITY_FAST,
+        .layout = MESH_BVH_TRIANGLES_COMPACT,
+        .traversal_cost = 1.0f,
+        .intersection_cost = 1.0f};
+}
+
+MeshBVHBuildSettings MeshBVHBuildSettings_HighQuality()
+{
+    MeshBVHBuildSettings settings = MeshBVHBuildSettings_Default();
+    settings.max_triangles_per_leaf = 4;
+    settings.bin_count = 32;
+    settings.quality = MESH_BVH_QUALITY_HIGH;
+    settings.layout = MESH_BVH_TRIANGLES_EDGES;
+    return settings;
+}
+
+MeshBVH *MeshBVH_Create(Mesh *mesh, MeshBVHBuildSettings settings)
+{
+    if (!mesh || !mesh->vertices)
     {
-        triangle_count = mesh->vertices_size / 3;
+        LogError(&_logConfig, "Invalid mesh provided to MeshBVH_Create");
+        return NULL;
     }
     
+    uint32_t triangle_count = MeshTriangleCount(mesh);
     if (triangle_count == 0)
     {
         LogWarning(&_logConfig, "Mesh has no triangles");
@@ -338,121 +849,257 @@ MeshBVH *MeshBVH_Create(Mesh *mesh, uint32_t max_triangles_per_leaf)
     MeshBVH *bvh = malloc(sizeof(MeshBVH));
     memset(bvh, 0, sizeof(MeshBVH));
     
-    bvh->triangle_count = triangle_count;
-    bvh->max_triangles_per_leaf = max_triangles_per_leaf;
-    bvh->triangles = malloc(sizeof(BVHTriangle) * triangle_count);
-    
-    // Build triangle list with precomputed data
-    for (uint32_t i = 0; i < triangle_count; i++)
+    // Keep the settings in range
+    if (settings.bin_count < 2)
+        settings.bin_count = 2;
+    if (settings.bin_count > MESH_BVH_MAX_BINS)
+        settings.bin_count = MESH_BVH_MAX_BINS;
+    if (settings.max_triangles_per_leaf < 1)
+        settings.max_triangles_per_leaf = 1;
+    bvh->settings = settings;
+    bvh->mesh = mesh;
+
+    // Large meshes are worth caching, their tree only depends on the hashed data
+    uint64_t hash = 0;
+    bool use_cache = triangle_count >= MESH_BVH_CACHE_MIN_TRIANGLES;
+    if (use_cache)
     {
-        BVHTriangle *tri = &bvh->triangles[i];
-        
-        // Get triangle vertices
-        if (mesh->indices && mesh->indices_size > 0)
-        {
-            tri->indices[0] = mesh->indices[i * 3];
-            tri->indices[1] = mesh->indices[i * 3 + 1];
-            tri->indices[2] = mesh->indices[i * 3 + 2];
-            
-            tri->vertices[0] = mesh->vertices[tri->indices[0]].position;
-            tri->vertices[1] = mesh->vertices[tri->indices[1]].position;
-            tri->vertices[2] = mesh->vertices[tri->indices[2]].position;
-        }
-        else
-        {
-            tri->indices[0] = i * 3;
-            tri->indices[1] = i * 3 + 1;
-            tri->indices[2] = i * 3 + 2;
-            
-            tri->vertices[0] = mesh->vertices[i * 3].position;
-            tri->vertices[1] = mesh->vertices[i * 3 + 1].position;
-            tri->vertices[2] = mesh->vertices[i * 3 + 2].position;
-        }
-        
-        // Calculate centroid
-        tri->centroid = V3_SCALE(V3_ADD(V3_ADD(tri->vertices[0], tri->vertices[1]), tri->vertices[2]), 1.0f / 3.0f);
-        
-        // Calculate normal
-        V3 edge1 = V3_SUB(tri->vertices[1], tri->vertices[0]);
-        V3 edge2 = V3_SUB(tri->vertices[2], tri->vertices[0]);
-        tri->normal = V3_NORM(V3_CROSS(edge1, edge2));
-        
-        // Calculate bounds
-        tri->bounds.min = tri->vertices[0];
-        tri->bounds.max = tri->vertices[0];
-        
-        for (int j = 1; j < 3; j++)
-        {
-            if (tri->vertices[j].x < tri->bounds.min.x) tri->bounds.min.x = tri->vertices[j].x;
-            if (tri->vertices[j].y < tri->bounds.min.y) tri->bounds.min.y = tri->vertices[j].y;
-            if (tri->vertices[j].z < tri->bounds.min.z) tri->bounds.min.z = tri->vertices[j].z;
-            
-            if (tri->vertices[j].x > tri->bounds.max.x) tri->bounds.max.x = tri->vertices[j].x;
-            if (tri->vertices[j].y > tri->bounds.max.y) tri->bounds.max.y = tri->vertices[j].y;
-            if (tri->vertices[j].z > tri->bounds.max.z) tri->bounds.max.z = tri->vertices[j].z;
-        }
+        hash = HashMesh(mesh, settings);
+        if (LoadCache(bvh, triangle_count, hash))
+            return bvh;
     }
+
+    BuildTree(bvh, triangle_count);
+    if (use_cache)
+        WriteCache(bvh, hash);
     
-    // Build BVH tree
-    bvh->total_nodes = 0;
-    bvh->leaf_nodes = 0;
-    bvh->max_depth = 0;
-    
-    bvh->root = BuildBVHNode(bvh->triangles, triangle_count, max_triangles_per_leaf, 0,
-                             &bvh->total_nodes, &bvh->leaf_nodes, &bvh->max_depth);
-    
-    LogSuccess(&_logConfig, "BVH created: %u nodes (%u leaves), max depth %u", 
-               bvh->total_nodes, bvh->leaf_nodes, bvh->max_depth);
+    LogSuccess(&_logConfig, "BVH created: %u nodes (%u leaves), max depth %u, SAH cost %.2f", 
+               bvh->total_nodes, bvh->leaf_nodes, bvh->max_depth, bvh->sah_cost);
     
     return bvh;
 }
 
-static void FreeBVHNode(BVHNode *node)
+void MeshBVH_Free(MeshBVH *bvh)
 {
-    if (!node)
+    if (!bvh)
         return;
     
-    if (node->is_leaf)
+    FreeTree(bvh);
+    free(bvh);
+    
+    LogSuccess(&_logConfig, "BVH freed");
+}
+
+/**
+ * @brief Map every mesh triangle to the leaf holding it, so a refit only reads the triangles of the leaves it touches
+ */
+static void BuildTriangleLeaves(MeshBVH *bvh)
+{
+    bvh->triangle_leaves = malloc(sizeof(uint32_t) * bvh->triangle_count);
+    bvh->dirty_nodes = calloc(bvh->total_nodes, sizeof(bool));
+    for (uint32_t i = 0; i < bvh->total_nodes; i++)
     {
-        free(node->triangles);
+        const BVHNode *node = &bvh->nodes[i];
+        for (uint32_t t = node->offset; t < node->offset + node->count; t++)
+            bvh->triangle_leaves[bvh->triangles[t]] = i;
     }
+}
+
+/**
+ * @brief List the triangles using each vertex of an indexed mesh, so a vertex edit only flags the leaves it moves
+ */
+static void BuildVertexTriangles(MeshBVH *bvh)
+{
+    const Mesh *mesh = bvh->mesh;
+    uint32_t vertex_count = (uint32_t)mesh->vertices_size;
+    uint32_t index_count = bvh->triangle_count * 3;
+    uint32_t *offsets = calloc(vertex_count + 1, sizeof(uint32_t));
+    for (uint32_t i = 0; i < index_count; i++)
+    {
+        if (mesh->indices[i] < vertex_count)
+            offsets[mesh->indices[i] + 1]++;
+    }
+    for (uint32_t v = 0; v < vertex_count; v++)
+        offsets[v + 1] += offsets[v];
+    uint32_t *triangles = malloc(sizeof(uint32_t) * (offsets[vertex_count] > 0 ? offsets[vertex_count] : 1));
+    // Filling advances every vertex's start to the next one's, shift them back afterwards
+    for (uint32_t i = 0; i < index_count; i++)
+    {
+        if (mesh->indices[i] < vertex_count)
+            triangles[offsets[mesh->indices[i]]++] = i / 3;
+    }
+    for (uint32_t v = vertex_count; v > 0; v--)
+        offsets[v] = offsets[v - 1];
+    offsets[0] = 0;
+    bvh->vertex_triangle_offsets = offsets;
+    bvh->vertex_triangles = triangles;
+    bvh->vertex_count = vertex_count;
+}
+
+/**
+ * @brief Rebuild from scratch when triangles were added or removed, the tree no longer matches the mesh
+ * @return True if the tree was rebuilt
+ */
+static bool RebuildIfResized(MeshBVH *bvh, Mesh *mesh)
+{
+    bvh->mesh = mesh;
+    uint32_t mesh_triangles = MeshTriangleCount(mesh);
+    if (mesh_triangles == bvh->triangle_count)
+        return false;
+    LogWarning(&_logConfig, "Triangle count changed (%u -> %u), rebuilding", bvh->triangle_count, mesh_triangles);
+    FreeTree(bvh);
+    if (mesh_triangles > 0)
+        BuildTree(bvh, mesh_triangles);
     else
+        bvh->triangle_count = 0;
+    return true;
+}
+
+/**
+ * @brief Refit the flagged leaves, their ancestors and the wide tree, then clear the flags
+ * @param dirty MeshBVH::dirty_nodes with the edited leaves flagged, NULL to refit every leaf
+ * @return True if the tree was rebuilt
+ */
+static bool RefitNodes(MeshBVH *bvh, bool *dirty)
+{
+    // Children come after their parent, so a reverse sweep refits bottom-up
+    for (uint32_t i = bvh->total_nodes; i-- > 0;)
     {
-        FreeBVHNode(node->left);
-        FreeBVHNode(node->right);
+        BVHNode *node = &bvh->nodes[i];
+        if (node->count > 0)
+        {
+            if (dirty && !dirty[i])
+                continue;
+            // Leaves read the current positions from the mesh
+            node->min = (V3){FLT_MAX, FLT_MAX, FLT_MAX};
+            node->max = (V3){-FLT_MAX, -FLT_MAX, -FLT_MAX};
+            for (uint32_t t = node->offset; t < node->offset + node->count; t++)
+            {
+                V3 vertices[3];
+                MeshBVH_GetTriangle(bvh, bvh->triangles[t], vertices);
+                node->min = V3_MIN(node->min, V3_MIN(V3_MIN(vertices[0], vertices[1]), vertices[2]));
+                node->max = V3_MAX(node->max, V3_MAX(V3_MAX(vertices[0], vertices[1]), vertices[2]));
+            }
+        }
+        else
+        {
+            if (dirty)
+            {
+                if (!dirty[i + 1] && !dirty[i + node->offset])
+                    continue;
+                dirty[i] = true;
+            }
+            const BVHNode *left = &bvh->nodes[i + 1];
+            const BVHNode *right = &bvh->nodes[i + node->offset];
+            node->min = V3_MIN(left->min, right->min);
+            node->max = V3_MAX(left->max, right->max);
+        }
     }
-    
-    free(node);
+    bvh->sah_cost = TreeCost(bvh);
+
+    // Triangles moved too far from where the splits were chosen
+    if (bvh->sah_cost > bvh->build_sah_cost * MESH_BVH_REBUILD_COST_FACTOR)
+    {
+        Log(&_logConfig, "SAH cost degraded from %.2f to %.2f, rebuilding", bvh->build_sah_cost, bvh->sah_cost);
+        FreeTree(bvh);
+        BuildTree(bvh, bvh->triangle_count);
+        return true;
+    }
+
+    // The flags stay set until the wide tree saw which nodes changed
+    MeshBVHWide_Refit(bvh->wide, bvh, dirty);
+    if (dirty)
+        memset(dirty, 0, sizeof(bool) * bvh->total_nodes);
+    return false;
 }
 
-void MeshBVH_Free(MeshBVH *bvh)
+bool MeshBVH_Refit(MeshBVH *bvh, Mesh *mesh, uint32_t first_triangle, uint32_t triangle_count)
 {
-    if (!bvh)
+    if (!bvh || !mesh || !mesh->vertices)
+        return false;
+    if (RebuildIfResized(bvh, mesh))
+        return true;
+    // The range may hold edited indices, the triangles using each vertex are listed again when needed
+    FreeVertexTriangles(bvh);
+
+    if (first_triangle >= bvh->triangle_count || triangle_count == 0)
+        return false;
+    uint32_t last_triangle = triangle_count > bvh->triangle_count - first_triangle ? bvh->triangle_count
+                                                                                   : first_triangle + triangle_count;
+    if (first_triangle == 0 && last_triangle == bvh->triangle_count)
+        return RefitNodes(bvh, NULL);
+
+    // A partial edit flags the leaves holding its triangles, the sweep then skips every clean subtree
+    if (!bvh->triangle_leaves)
+        BuildTriangleLeaves(bvh);
+    for (uint32_t t = first_triangle; t < last_triangle; t++)
+        bvh->dirty_nodes[bvh->triangle_leaves[t]] = true;
+    return RefitNodes(bvh, bvh->dirty_nodes);
+}
+
+bool MeshBVH_RefitVertices(MeshBVH *bvh, Mesh *mesh, uint32_t first_vertex, uint32_t vertex_count)
+{
+    if (!bvh || !mesh || !mesh->vertices)
+        return false;
+    // Triangles of non-indexed meshes own three consecutive vertices
+    if (!mesh->indices || mesh->indices_size == 0)
+    {
+        uint64_t triangle_count = ((uint64_t)first_vertex % 3 + vertex_count + 2) / 3;
+        return MeshBVH_Refit(bvh, mesh, first_vertex / 3, triangle_count > UINT32_MAX ? UINT32_MAX : (uint32_t)triangle_count);
+    }
+    if (RebuildIfResized(bvh, mesh))
+        return true;
+
+    uint32_t mesh_vertices = (uint32_t)mesh->vertices_size;
+    if (first_vertex >= mesh_vertices || vertex_count == 0)
+        return false;
+    uint32_t last_vertex = vertex_count > mesh_vertices - first_vertex ? mesh_vertices : first_vertex + vertex_count;
+    if (first_vertex == 0 && last_vertex == mesh_vertices)
+        return RefitNodes(bvh, NULL);
+
+    if (bvh->vertex_triangles && bvh->vertex_count != mesh_vertices)
+        FreeVertexTriangles(bvh);
+    if (!bvh->vertex_triangles)
+        BuildVertexTriangles(bvh);
+    if (!bvh->triangle_leaves)
+        BuildTriangleLeaves(bvh);
+    for (uint32_t v = first_vertex; v < last_vertex; v++)
+    {
+        for (uint32_t i = bvh->vertex_triangle_offsets[v]; i < bvh->vertex_triangle_offsets[v + 1]; i++)
+            bvh->dirty_nodes[bvh->triangle_leaves[bvh->vertex_triangles[i]]] = true;
+    }
+    return RefitNodes(bvh, bvh->dirty_nodes);
+}
+
+void MeshBVH_GetTriangle(const MeshBVH *bvh, uint32_t triangle, V3 *out_vertices)
+{
+    const Mesh *mesh = bvh->mesh;
+    if (mesh->indices && mesh->indices_size > 0)
+    {
+        const uint32_t *indices = &mesh->indices[triangle * 3];
+        out_vertices[0] = mesh->vertices[indices[0]].position;
+        out_vertices[1] = mesh->vertices[indices[1]].position;
+        out_vertices[2] = mesh->vertices[indices[2]].position;
         return;
-    
-    FreeBVHNode(bvh->root);
-    free(bvh->triangles);
-    free(bvh);
-    
-    LogSuccess(&_logConfig, "BVH freed");
+    }
+    out_vertices[0] = mesh->vertices[triangle * 3].position;
+    out_vertices[1] = mesh->vertices[triangle * 3 + 1].position;
+    out_vertices[2] = mesh->vertices[triangle * 3 + 2].position;
 }
 
 bool MeshBVH_Raycast(MeshBVH *bvh, V3 origin, V3 direction, float max_distance, BVHRaycastHit *hit)
 {
-    if (!bvh || !bvh->root || !hit)
+    if (!bvh || !bvh->nodes || !hit)
         return false;
     
     // Initialize hit result
     hit->hit = false;
     hit->distance = max_distance;
-    hit->triangle = NULL;
     hit->triangle_index = 0;
     
-    // Ensure direction is normalized
-    direction = V3_NORM(direction);
-    
-    // Traverse BVH
-    return TraverseBVH(bvh->root, origin, direction, max_distance, hit);
+    // Traverse the wide tree when it was built, the binary one otherwise
+    return bvh->wide ? MeshBVHWide_Raycast(bvh->wide, origin, direction, hit)
+                     : TraverseBVH(bvh, origin, direction, hit);
 }
 
 void MeshBVH_PrintStats(MeshBVH *bvh)
@@ -468,86 +1115,14 @@ void MeshBVH_PrintStats(MeshBVH *bvh)
     Log(&_logConfig, "  Total nodes: %u", bvh->total_nodes);
     Log(&_logConfig, "  Leaf nodes: %u", bvh->leaf_nodes);
     Log(&_logConfig, "  Max depth: %u", bvh->max_depth);
-    Log(&_logConfig, "  Max triangles per leaf: %u", bvh->max_triangles_per_leaf);
+    Log(&_logConfig, "  Max triangles per leaf: %u", bvh->settings.max_triangles_per_leaf);
+    Log(&_logConfig, "  Bins: %u (%s)", bvh->settings.bin_count, bvh->settings.quality == MESH_BVH_QUALITY_HIGH ? "all axes" : "longest axis");
+    Log(&_logConfig, "  SAH cost: %.2f", bvh->sah_cost);
+    Log(&_logConfig, "  Triangles stored: %s", bvh->settings.layout == MESH_BVH_TRIANGLES_EDGES ? "precomputed edges" : "compact");
+    if (bvh->wide)
+        Log(&_logConfig, "  Wide nodes: %u (%d-wide, %s), triangle packets: %u", bvh->wide->nodes_size,
+            MESH_BVH_WIDTH, MESH_BVH_SIMD, bvh->wide->packets_size);
     
     float avg_triangles_per_leaf = bvh->leaf_nodes > 0 ? (float)bvh->triangle_count / bvh->leaf_nodes : 0.0f;
     Log(&_logConfig, "  Avg triangles per leaf: %.2f", avg_triangles_per_leaf);
 }
-
-void MeshBVH_UpdateTransform(MeshBVH *bvh, Mesh *mesh, V3 worldPos, V3 worldScale, 
-                            V3 right, V3 up, V3 forward, V3 offset)
-{
-    if (!bvh || !mesh)
-        return;
-    
-    // Transform offset into world space
-    V3 offsetWorld = {
-        offset.x * right.x + offset.y * up.x + offset.z * forward.x,
-        offset.x * right.y + offset.y * up.y + offset.z * forward.y,
-        offset.x * right.z + offset.y * up.z + offset.z * forward.z
-    };
-    
-    // Update all triangle vertices to world space
-    for (uint32_t i = 0; i < bvh->triangle_count; i++)
-    {
-        BVHTriangle *tri = &bvh->triangles[i];
-        
-        // Get original local vertices
-        V3 localVerts[3];
-        if (mesh->indices && mesh->indices_size > 0)
-        {
-            localVerts[0] = mesh->vertices[tri->indices[0]].position;
-            localVerts[1] = mesh->vertices[tri->indices[1]].position;
-            localVerts[2] = mesh->vertices[tri->indices[2]].position;
-        }
-        else
-        {
-            localVerts[0] = mesh->vertices[i * 3].position;
-            localVerts[1] = mesh->vertices[i * 3 + 1].position;
-            localVerts[2] = mesh->vertices[i * 3 + 2].position;
-        }
-        
-        // Transform to world space
-        for (int j = 0; j < 3; j++)
-        {
-            // Apply scale
-            V3 scaled = V3_MUL(localVerts[j], worldScale);
-            
-            // Apply rotation
-            tri->vertices[j] = (V3){
-                scaled.x * right.x + scaled.y * up.x + scaled.z * forward.x + worldPos.x,
-                scaled.x * right.y + scaled.y * up.y + scaled.z * forward.y + worldPos.y,
-                scaled.x * right.z + scaled.y * up.z + scaled.z * forward.z + worldPos.z
-            };
-            
-            // Apply offset
-            tri->vertices[j] = V3_ADD(tri->vertices[j], offsetWorld);
-        }
-        
-        // Recalculate derived data
-        tri->centroid = V3_SCALE(V3_ADD(V3_ADD(tri->vertices[0], tri->vertices[1]), tri->vertices[2]), 1.0f / 3.0f);
-        
-        V3 edge1 = V3_SUB(tri->vertices[1], tri->vertices[0]);
-        V3 edge2 = V3_SUB(tri->vertices[2], tri->vertices[0]);
-        tri->normal = V3_NORM(V3_CROSS(edge1, edge2));
-        
-        // Recalculate bounds
-        tri->bounds.min = tri->vertices[0];
-        tri->bounds.max = tri->vertices[0];
-        
-        for (int j = 1; j < 3; j++)
-        {
-            if (tri->vertices[j].x < tri->bounds.min.x) tri->bounds.min.x = tri->vertices[j].x;
-            if (tri->vertices[j].y < tri->bounds.min.y) tri->bounds.min.y = tri->vertices[j].y;
-            if (tri->vertices[j].z < tri->bounds.min.z) tri->bounds.min.z = tri->vertices[j].z;
-            
-            if (tri->vertices[j].x > tri->bounds.max.x) tri->bounds.max.x = tri->vertices[j].x;
-            if (tri->vertices[j].y > tri->bounds.max.y) tri->bounds.max.y = tri->vertices[j].y;
-            if (tri->vertices[j].z > tri->bounds.max.z) tri->bounds.max.z = tri->vertices[j].z;
-        }
-    }
-    
-    // TODO: Rebuild BVH tree with updated triangle data
-    // For now, we just update triangle data. For full optimization,
-    // you'd want to rebuild the tree structure as well.
-}
\ No newline at end of file
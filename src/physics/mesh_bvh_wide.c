@@ -0,0 +1,582 @@
+#include "physics/mesh_bvh_wide.h"
+#include "logging/logger.h"
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <float.h>
+
+// -------------------------
+// Static Variables
+// -------------------------
+
+static LogConfig _logConfig = {"MeshBVHWide", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
+
+/// @brief Every wide node pushes at most MESH_BVH_WIDTH children and is never deeper than its binary node
+#define MESH_BVH_WIDE_STACK_SIZE (MESH_BVH_STACK_SIZE * MESH_BVH_WIDTH)
+#define MESH_BVH_WIDE_EPSILON 0.0000001f
+
+// -------------------------
+// Vector Helpers
+// -------------------------
+
+// Comparisons return one bit per lane. Ordered: lanes holding NaN always compare false.
+#if MESH_BVH_WIDTH == 8
+#include <immintrin.h>
+
+typedef __m256 VFloat;
+
+#define VLoad(p) _mm256_loadu_ps(p)
+#define VStore(p, a) _mm256_storeu_ps(p, a)
+#define VSet(x) _mm256_set1_ps(x)
+#define VAdd(a, b) _mm256_add_ps(a, b)
+#define VSub(a, b) _mm256_sub_ps(a, b)
+#define VMul(a, b) _mm256_mul_ps(a, b)
+#define VDiv(a, b) _mm256_div_ps(a, b)
+#define VMin(a, b) _mm256_min_ps(a, b)
+#define VMax(a, b) _mm256_max_ps(a, b)
+#define VLess(a, b) ((uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)))
+#define VLessEqual(a, b) ((uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ)))
+
+#elif MESH_BVH_WIDTH == 4 && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+
+typedef __m128 VFloat;
+
+#define VLoad(p) _mm_loadu_ps(p)
+#define VStore(p, a) _mm_storeu_ps(p, a)
+#define VSet(x) _mm_set1_ps(x)
+#define VAdd(a, b) _mm_add_ps(a, b)
+#define VSub(a, b) _mm_sub_ps(a, b)
+#define VMul(a, b) _mm_mul_ps(a, b)
+#define VDiv(a, b) _mm_div_ps(a, b)
+#define VMin(a, b) _mm_min_ps(a, b)
+#define VMax(a, b) _mm_max_ps(a, b)
+#define VLess(a, b) ((uint32_t)_mm_movemask_ps(_mm_cmplt_ps(a, b)))
+#define VLessEqual(a, b) ((uint32_t)_mm_movemask_ps(_mm_cmple_ps(a, b)))
+
+#else
+
+typedef struct
+{
+    float v[MESH_BVH_WIDTH];
+} VFloat;
+
+#define V_LANES(expr)                             \
+    VFloat r;                                     \
+    for (int i = 0; i < MESH_BVH_WIDTH; i++)      \
+        r.v[i] = (expr);                          \
+    return r
+
+inline static VFloat VLoad(const float *p) { V_LANES(p[i]); }
+inline static void VStore(float *p, VFloat a) { memcpy(p, a.v, sizeof(a.v)); }
+inline static VFloat VSet(float x) { V_LANES(x); }
+inline static VFloat VAdd(VFloat a, VFloat b) { V_LANES(a.v[i] + b.v[i]); }
+inline static VFloat VSub(VFloat a, VFloat b) { V_LANES(a.v[i] - b.v[i]); }
+inline static VFloat VMul(VFloat a, VFloat b) { V_LANES(a.v[i] * b.v[i]); }
+inline static VFloat VDiv(VFloat a, VFloat b) { V_LANES(a.v[i] / b.v[i]); }
+// Same NaN behaviour as minps/maxps: the second operand wins
+inline static VFloat VMin(VFloat a, VFloat b) { V_LANES(a.v[i] < b.v[i] ? a.v[i] : b.v[i]); }
+inline static VFloat VMax(VFloat a, VFloat b) { V_LANES(a.v[i] > b.v[i] ? a.v[i] : b.v[i]); }
+
+inline static uint32_t VLess(VFloat a, VFloat b)
+{
+    uint32_t mask = 0;
+    for (int i = 0; i < MESH_BVH_WIDTH; i++)
+        mask |= (uint32_t)(a.v[i] < b.v[i]) << i;
+    return mask;
+}
+
+inline static uint32_t VLessEqual(VFloat a, VFloat b)
+{
+    uint32_t mask = 0;
+    for (int i = 0; i < MESH_BVH_WIDTH; i++)
+        mask |= (uint32_t)(a.v[i] <= b.v[i]) << i;
+    return mask;
+}
+
+#undef V_LANES
+#endif
+
+// -------------------------
+// Collapse
+// -------------------------
+
+typedef struct
+{
+    const MeshBVH *bvh;
+    MeshBVHWide *wide;
+} CollapseContext;
+
+inline static float NodeArea(const BVHNode *node)
+{
+    V3 d = V3_SUB(node->max, node->min);
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+/**
+ * @brief Number of triangles below a binary node, which are contiguous in MeshBVH::triangles
+ * @param out_first Slot of the first one
+ */
+static uint32_t SubtreeTriangles(const BVHNode *nodes, uint32_t index, uint32_t *out_first)
+{
+    uint32_t first = index, last = index;
+    while (nodes[first].count == 0)
+        first++;
+    while (nodes[last].count == 0)
+        last += nodes[last].offset;
+    *out_first = nodes[first].offset;
+    return nodes[last].offset + nodes[last].count - nodes[first].offset;
+}
+
+/**
+ * @brief Write a range of triangles into consecutive packets from the current vertex positions, padding the last one
+ */
+static void FillPackets(const MeshBVH *bvh, uint32_t first, uint32_t count, BVHTrianglePacket *packets_out)
+{
+    // Same lookup as MeshBVH_GetTriangle, spelled out since compact raycasts run it for every leaf they open
+    const Mesh *mesh = bvh->mesh;
+    const uint32_t *indices = mesh->indices && mesh->indices_size > 0 ? mesh->indices : NULL;
+    uint32_t packets = (count + MESH_BVH_WIDTH - 1) / MESH_BVH_WIDTH;
+    for (uint32_t p = 0; p < packets; p++)
+    {
+        BVHTrianglePacket *packet = &packets_out[p];
+        for (uint32_t lane = 0; lane < MESH_BVH_WIDTH; lane++)
+        {
+            uint32_t i = p * MESH_BVH_WIDTH + lane;
+            if (i >= count)
+            {
+                packet->v0_x[lane] = packet->v0_y[lane] = packet->v0_z[lane] = 0.0f;
+                packet->e1_x[lane] = packet->e1_y[lane] = packet->e1_z[lane] = 0.0f;
+                packet->e2_x[lane] = packet->e2_y[lane] = packet->e2_z[lane] = 0.0f;
+                packet->triangle[lane] = UINT32_MAX;
+                continue;
+            }
+            uint32_t triangle = bvh->triangles[first + i];
+            const uint32_t *corners = indices ? &indices[triangle * 3] : (const uint32_t[3]){triangle * 3, triangle * 3 + 1, triangle * 3 + 2};
+            V3 v0 = mesh->vertices[corners[0]].position;
+            V3 v1 = mesh->vertices[corners[1]].position;
+            V3 v2 = mesh->vertices[corners[2]].position;
+            packet->v0_x[lane] = v0.x;
+            packet->v0_y[lane] = v0.y;
+            packet->v0_z[lane] = v0.z;
+            packet->e1_x[lane] = v1.x - v0.x;
+            packet->e1_y[lane] = v1.y - v0.y;
+            packet->e1_z[lane] = v1.z - v0.z;
+            packet->e2_x[lane] = v2.x - v0.x;
+            packet->e2_y[lane] = v2.y - v0.y;
+            packet->e2_z[lane] = v2.z - v0.z;
+            packet->triangle[lane] = triangle;
+        }
+    }
+}
+
+/**
+ * @brief Append a range of triangles as packets
+ * @return Index of the first packet
+ */
+static uint32_t EmitPackets(CollapseContext *ctx, uint32_t first, uint32_t count, uint32_t *out_packets)
+{
+    MeshBVHWide *wide = ctx->wide;
+    uint32_t packets = (count + MESH_BVH_WIDTH - 1) / MESH_BVH_WIDTH;
+    if (wide->packets_size + packets > wide->packets_capacity)
+    {
+        while (wide->packets_size + packets > wide->packets_capacity)
+            wide->packets_capacity = wide->packets_capacity == 0 ? 64 : wide->packets_capacity * 2;
+        wide->packets = realloc(wide->packets, sizeof(BVHTrianglePacket) * wide->packets_capacity);
+    }
+
+    uint32_t start = wide->packets_size;
+    FillPackets(ctx->bvh, first, count, &wide->packets[start]);
+    wide->packets_size += packets;
+    *out_packets = packets;
+    return start;
+}
+
+/**
+ * @brief Whether a child becomes packets rather than a nested wide node. Small subtrees fit a single packet,
+ * testing it costs as much as testing a binary leaf's one or two triangles.
+ */
+inline static bool IsPacketChild(const BVHNode *nodes, uint32_t index, uint32_t *out_first, uint32_t *out_count)
+{
+    if (nodes[index].count > 0)
+    {
+        *out_first = nodes[index].offset;
+        *out_count = nodes[index].count;
+        return true;
+    }
+    *out_count = SubtreeTriangles(nodes, index, out_first);
+    return *out_count <= MESH_BVH_WIDTH;
+}
+
+/**
+ * @brief Turn a binary subtree into a wide node by repeatedly opening its largest internal child
+ * @return Index of the wide node
+ */
+static uint32_t CollapseNode(CollapseContext *ctx, uint32_t binary_index)
+{
+    const BVHNode *nodes = ctx->bvh->nodes;
+    uint32_t children[MESH_BVH_WIDTH];
+    bool packet_child[MESH_BVH_WIDTH];
+    uint32_t first[MESH_BVH_WIDTH];
+    uint32_t count[MESH_BVH_WIDTH];
+    uint32_t children_size = 1;
+    children[0] = binary_index;
+    // The root is opened even when small, a wide node needs at least one child
+    packet_child[0] = nodes[binary_index].count > 0;
+    if (packet_child[0])
+        IsPacketChild(nodes, binary_index, &first[0], &count[0]);
+
+    while (children_size < MESH_BVH_WIDTH)
+    {
+        int largest = -1;
+        float largest_area = -1.0f;
+        for (uint32_t i = 0; i < children_size; i++)
+        {
+            const BVHNode *child = &nodes[children[i]];
+            if (!packet_child[i] && NodeArea(child) > largest_area)
+            {
+                largest = (int)i;
+                largest_area = NodeArea(child);
+            }
+        }
+        if (largest < 0)
+            break;
+        uint32_t opened = children[largest];
+        uint32_t added = children_size++;
+        children[largest] = opened + 1;
+        children[added] = opened + nodes[opened].offset;
+        packet_child[largest] = IsPacketChild(nodes, children[largest], &first[largest], &count[largest]);
+        packet_child[added] = IsPacketChild(nodes, children[added], &first[added], &count[added]);
+    }
+
+    MeshBVHWide *wide = ctx->wide;
+    if (wide->nodes_size >= wide->nodes_capacity)
+    {
+        wide->nodes_capacity = wide->nodes_capacity == 0 ? 16 : wide->nodes_capacity * 2;
+        wide->nodes = realloc(wide->nodes, sizeof(BVHWideNode) * wide->nodes_capacity);
+        wide->sources = realloc(wide->sources, sizeof(uint32_t) * MESH_BVH_WIDTH * wide->nodes_capacity);
+    }
+    uint32_t index = wide->nodes_size++;
+    BVHWideNode *wide_node = &wide->nodes[index];
+    for (uint32_t lane = 0; lane < MESH_BVH_WIDTH; lane++)
+    {
+        wide->sources[index * MESH_BVH_WIDTH + lane] = lane < children_size ? children[lane] : UINT32_MAX;
+        if (lane >= children_size)
+        {
+            wide_node->min_x[lane] = wide_node->min_y[lane] = wide_node->min_z[lane] = NAN;
+            wide_node->max_x[lane] = wide_node->max_y[lane] = wide_node->max_z[lane] = NAN;
+            wide_node->child[lane] = UINT32_MAX;
+            wide_node->count[lane] = MESH_BVH_WIDE_INTERNAL;
+            continue;
+        }
+        const BVHNode *child = &nodes[children[lane]];
+        wide_node->min_x[lane] = child->min.x;
+        wide_node->min_y[lane] = child->min.y;
+        wide_node->min_z[lane] = child->min.z;
+        wide_node->max_x[lane] = child->max.x;
+        wide_node->max_y[lane] = child->max.y;
+        wide_node->max_z[lane] = child->max.z;
+        if (packet_child[lane] && ctx->bvh->settings.layout == MESH_BVH_TRIANGLES_COMPACT)
+        {
+            wide_node->child[lane] = first[lane];
+            wide_node->count[lane] = count[lane];
+        }
+        else if (packet_child[lane])
+        {
+            wide_node->child[lane] = EmitPackets(ctx, first[lane], count[lane], &wide_node->count[lane]);
+        }
+        else
+        {
+            uint32_t child_index = CollapseNode(ctx, children[lane]);
+            // The recursion may have grown the node array
+            wide_node = &wide->nodes[index];
+            wide_node->child[lane] = child_index;
+            wide_node->count[lane] = MESH_BVH_WIDE_INTERNAL;
+        }
+    }
+    return index;
+}
+
+// -------------------------
+// Traversal
+// -------------------------
+
+typedef struct
+{
+    VFloat origin_x, origin_y, origin_z;
+    VFloat direction_x, direction_y, direction_z;
+    VFloat inv_x, inv_y, inv_z;
+} WideRay;
+
+/**
+ * @brief Slab test of one ray against every child of a node
+ * @param t_enter Per lane entry distance
+ * @return Bit per child hit before max_distance
+ */
+inline static uint32_t RayIntersectsChildren(const WideRay *ray, const BVHWideNode *node, float max_distance, float *t_enter)
+{
+    VFloat t1 = VMul(VSub(VLoad(node->min_x), ray->origin_x), ray->inv_x);
+    VFloat t2 = VMul(VSub(VLoad(node->max_x), ray->origin_x), ray->inv_x);
+    VFloat t3 = VMul(VSub(VLoad(node->min_y), ray->origin_y), ray->inv_y);
+    VFloat t4 = VMul(VSub(VLoad(node->max_y), ray->origin_y), ray->inv_y);
+    VFloat t5 = VMul(VSub(VLoad(node->min_z), ray->origin_z), ray->inv_z);
+    VFloat t6 = VMul(VSub(VLoad(node->max_z), ray->origin_z), ray->inv_z);
+
+    VFloat tmin = VMax(VMax(VMin(t1, t2), VMin(t3, t4)), VMin(t5, t6));
+    VFloat tmax = VMin(VMin(VMax(t1, t2), VMax(t3, t4)), VMax(t5, t6));
+
+    VStore(t_enter, tmin);
+    return VLessEqual(tmin, tmax) & VLessEqual(VSet(0.0f), tmax) & VLessEqual(tmin, VSet(max_distance));
+}
+
+/**
+ * @brief Möller-Trumbore against every triangle of a packet
+ * @return Lane of the closest hit nearer than *distance, -1 if none. *distance is updated on a hit.
+ */
+inline static int RayIntersectsPacket(const WideRay *ray, const BVHTrianglePacket *packet, float *distance)
+{
+    VFloat e1_x = VLoad(packet->e1_x), e1_y = VLoad(packet->e1_y), e1_z = VLoad(packet->e1_z);
+    VFloat e2_x = VLoad(packet->e2_x), e2_y = VLoad(packet->e2_y), e2_z = VLoad(packet->e2_z);
+
+    // h = direction x e2
+    VFloat h_x = VSub(VMul(ray->direction_y, e2_z), VMul(ray->direction_z, e2_y));
+    VFloat h_y = VSub(VMul(ray->direction_z, e2_x), VMul(ray->direction_x, e2_z));
+    VFloat h_z = VSub(VMul(ray->direction_x, e2_y), VMul(ray->direction_y, e2_x));
+    VFloat a = VAdd(VAdd(VMul(e1_x, h_x), VMul(e1_y, h_y)), VMul(e1_z, h_z));
+    // Parallel rays and padding lanes (a == 0)
+    VFloat abs_a = VMax(a, VSub(VSet(0.0f), a));
+    uint32_t mask = VLessEqual(VSet(MESH_BVH_WIDE_EPSILON), abs_a);
+    if (!mask)
+        return -1;
+
+    VFloat f = VDiv(VSet(1.0f), a);
+    VFloat s_x = VSub(ray->origin_x, VLoad(packet->v0_x));
+    VFloat s_y = VSub(ray->origin_y, VLoad(packet->v0_y));
+    VFloat s_z = VSub(ray->origin_z, VLoad(packet->v0_z));
+    VFloat u = VMul(f, VAdd(VAdd(VMul(s_x, h_x), VMul(s_y, h_y)), VMul(s_z, h_z)));
+    mask &= VLessEqual(VSet(0.0f), u) & VLessEqual(u, VSet(1.0f));
+    if (!mask)
+        return -1;
+
+    // q = s x e1
+    VFloat q_x = VSub(VMul(s_y, e1_z), VMul(s_z, e1_y));
+    VFloat q_y = VSub(VMul(s_z, e1_x), VMul(s_x, e1_z));
+    VFloat q_z = VSub(VMul(s_x, e1_y), VMul(s_y, e1_x));
+    VFloat v = VMul(f, VAdd(VAdd(VMul(ray->direction_x, q_x), VMul(ray->direction_y, q_y)), VMul(ray->direction_z, q_z)));
+    VFloat t = VMul(f, VAdd(VAdd(VMul(e2_x, q_x), VMul(e2_y, q_y)), VMul(e2_z, q_z)));
+    mask &= VLessEqual(VSet(0.0f), v) & VLessEqual(VAdd(u, v), VSet(1.0f));
+    mask &= VLess(VSet(MESH_BVH_WIDE_EPSILON), t) & VLess(t, VSet(*distance));
+    if (!mask)
+        return -1;
+
+    // Closest lane, the first one on ties like the scalar loop
+    float ts[MESH_BVH_WIDTH];
+    VStore(ts, t);
+    int best = -1;
+    for (; mask; mask &= mask - 1)
+    {
+        int lane = __builtin_ctz(mask);
+        if (ts[lane] < *distance)
+        {
+            *distance = ts[lane];
+            best = lane;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Closest triangle so far, copied out of its packet since gathered packets do not outlive the leaf
+ */
+typedef struct
+{
+    bool found;
+    V3 edge1;
+    V3 edge2;
+    uint32_t triangle;
+} WideHit;
+
+inline static void KeepHit(WideHit *best, const BVHTrianglePacket *packet, int lane)
+{
+    best->found = true;
+    best->edge1 = (V3){packet->e1_x[lane], packet->e1_y[lane], packet->e1_z[lane]};
+    best->edge2 = (V3){packet->e2_x[lane], packet->e2_y[lane], packet->e2_z[lane]};
+    best->triangle = packet->triangle[lane];
+}
+
+/**
+ * @brief Complete the hit from the closest triangle, computing the normal only once
+ */
+static bool FillHit(const WideHit *best, V3 origin, V3 direction, BVHRaycastHit *hit)
+{
+    if (!best->found)
+        return false;
+    hit->hit = true;
+    hit->point = V3_ADD(origin, V3_SCALE(direction, hit->distance));
+    hit->normal = V3_NORM(V3_CROSS(best->edge1, best->edge2));
+    hit->triangle_index = best->triangle;
+    return true;
+}
+
+bool MeshBVHWide_Raycast(const MeshBVHWide *wide, V3 origin, V3 direction, BVHRaycastHit *hit)
+{
+    if (!wide || !wide->nodes)
+        return false;
+
+    // Directions are not normalized (local space of scaled meshes), only a zero component is degenerate
+    WideRay ray = {
+        .origin_x = VSet(origin.x),
+        .origin_y = VSet(origin.y),
+        .origin_z = VSet(origin.z),
+        .direction_x = VSet(direction.x),
+        .direction_y = VSet(direction.y),
+        .direction_z = VSet(direction.z),
+        .inv_x = VSet(direction.x != 0.0f ? 1.0f / direction.x : FLT_MAX),
+        .inv_y = VSet(direction.y != 0.0f ? 1.0f / direction.y : FLT_MAX),
+        .inv_z = VSet(direction.z != 0.0f ? 1.0f / direction.z : FLT_MAX)};
+
+    uint32_t stack[MESH_BVH_WIDE_STACK_SIZE];
+    float stack_enter[MESH_BVH_WIDE_STACK_SIZE];
+    int stack_size = 0;
+    WideHit best = {0};
+    bool gather = wide->bvh->settings.layout == MESH_BVH_TRIANGLES_COMPACT;
+    uint32_t index = 0;
+
+    while (true)
+    {
+        const BVHWideNode *node = &wide->nodes[index];
+        float t_enter[MESH_BVH_WIDTH];
+        uint32_t mask = RayIntersectsChildren(&ray, node, hit->distance, t_enter);
+
+        // Order the children hit, nearest first
+        uint32_t order[MESH_BVH_WIDTH];
+        int order_size = 0;
+        for (; mask; mask &= mask - 1)
+        {
+            uint32_t lane = (uint32_t)__builtin_ctz(mask);
+            int j = order_size++;
+            while (j > 0 && t_enter[order[j - 1]] > t_enter[lane])
+            {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = lane;
+        }
+
+        // Leaves right away, nearest first, so their hits cull the nodes pushed below
+        for (int i = 0; i < order_size; i++)
+        {
+            uint32_t lane = order[i];
+            if (node->count[lane] == MESH_BVH_WIDE_INTERNAL || t_enter[lane] > hit->distance)
+                continue;
+            uint32_t end = node->child[lane] + node->count[lane];
+            if (gather)
+            {
+                // Compact leaves, the same packets built from the mesh on the fly
+                for (uint32_t first = node->child[lane]; first < end; first += MESH_BVH_WIDTH)
+                {
+                    BVHTrianglePacket packet;
+                    FillPackets(wide->bvh, first, end - first < MESH_BVH_WIDTH ? end - first : MESH_BVH_WIDTH, &packet);
+                    int lane_hit = RayIntersectsPacket(&ray, &packet, &hit->distance);
+                    if (lane_hit >= 0)
+                        KeepHit(&best, &packet, lane_hit);
+                }
+                continue;
+            }
+            for (uint32_t p = node->child[lane]; p < end; p++)
+            {
+                int lane_hit = RayIntersectsPacket(&ray, &wide->packets[p], &hit->distance);
+                if (lane_hit >= 0)
+                    KeepHit(&best, &wide->packets[p], lane_hit);
+            }
+        }
+
+        // Farthest first, so the nearest child is popped next
+        for (int i = order_size - 1; i >= 0; i--)
+        {
+            uint32_t lane = order[i];
+            if (node->count[lane] != MESH_BVH_WIDE_INTERNAL)
+                continue;
+            stack[stack_size] = node->child[lane];
+            stack_enter[stack_size++] = t_enter[lane];
+        }
+
+        // Pop the next node the ray may still reach before the closest hit
+        do
+        {
+            if (stack_size == 0)
+                return FillHit(&best, origin, direction, hit);
+            stack_size--;
+        } while (stack_enter[stack_size] > hit->distance);
+        index = stack[stack_size];
+    }
+}
+
+// -------------------------
+// Creation & Destruction
+// -------------------------
+
+MeshBVHWide *MeshBVHWide_Create(const MeshBVH *bvh)
+{
+    if (!bvh || !bvh->nodes || bvh->total_nodes == 0)
+        return NULL;
+
+    MeshBVHWide *wide = malloc(sizeof(MeshBVHWide));
+    memset(wide, 0, sizeof(MeshBVHWide));
+    wide->bvh = bvh;
+    // Every wide node consumes at least one binary internal node, a lone root leaf still needs one
+    uint32_t internal_nodes = bvh->total_nodes - bvh->leaf_nodes;
+    wide->nodes_capacity = internal_nodes > 0 ? internal_nodes : 1;
+    wide->nodes = malloc(sizeof(BVHWideNode) * wide->nodes_capacity);
+    wide->sources = malloc(sizeof(uint32_t) * MESH_BVH_WIDTH * wide->nodes_capacity);
+
+    CollapseContext ctx = {bvh, wide};
+    CollapseNode(&ctx, 0);
+    wide->nodes_capacity = wide->nodes_size;
+    wide->nodes = realloc(wide->nodes, sizeof(BVHWideNode) * wide->nodes_capacity);
+    wide->sources = realloc(wide->sources, sizeof(uint32_t) * MESH_BVH_WIDTH * wide->nodes_capacity);
+
+    LogSuccess(&_logConfig, "Collapsed %u nodes into %u %d-wide nodes (%s), %u triangle packets",
+               bvh->total_nodes, wide->nodes_size, MESH_BVH_WIDTH, MESH_BVH_SIMD, wide->packets_size);
+    return wide;
+}
+
+void MeshBVHWide_Refit(MeshBVHWide *wide, const MeshBVH *bvh, const bool *dirty)
+{
+    if (!wide || !bvh || !bvh->nodes)
+        return;
+    // Slots over binary nodes the refit did not touch keep their bounds and packets
+    for (uint32_t i = 0; i < wide->nodes_size; i++)
+    {
+        BVHWideNode *wide_node = &wide->nodes[i];
+        for (uint32_t lane = 0; lane < MESH_BVH_WIDTH; lane++)
+        {
+            uint32_t source = wide->sources[i * MESH_BVH_WIDTH + lane];
+            if (source == UINT32_MAX || (dirty && !dirty[source]))
+                continue;
+            const BVHNode *child = &bvh->nodes[source];
+            wide_node->min_x[lane] = child->min.x;
+            wide_node->min_y[lane] = child->min.y;
+            wide_node->min_z[lane] = child->min.z;
+            wide_node->max_x[lane] = child->max.x;
+            wide_node->max_y[lane] = child->max.y;
+            wide_node->max_z[lane] = child->max.z;
+            if (bvh->settings.layout == MESH_BVH_TRIANGLES_EDGES && wide_node->count[lane] != MESH_BVH_WIDE_INTERNAL)
+            {
+                uint32_t first, count;
+                IsPacketChild(bvh->nodes, source, &first, &count);
+                FillPackets(bvh, first, count, &wide->packets[wide_node->child[lane]]);
+            }
+        }
+    }
+}
+
+void MeshBVHWide_Free(MeshBVHWide *wide)
+{
+    if (!wide)
+        return;
+    free(wide->nodes);
+    free(wide->sources);
+    free(wide->packets);
+    free(wide);
+}
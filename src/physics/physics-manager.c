@@ -1,5 +1,6 @@
 #include "physics/physics-manager.h"
 #include "physics/mesh_bvh.h"
+#include "physics/heightfield.h"
 #include "perceptron.h"
 // Entity
 #include "entity/entity.h"
@@ -7,8 +8,11 @@
 #include "entity/components/ec_rigidbody/ec_rigidbody.h"
 // Collider
 #include "entity/components/ec_collider/ec_collider.h"
+// Threading
+#include "utilities/thread/task_pool.h"
 // C
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 // Logging
 #include "logging/logger.h"
@@ -49,72 +53,349 @@ static const uint32_t COLLISION_MASK[] = {
 #define DYNAMIC_FRICTION_COEF 0.4f     // Dynamic friction coefficient
 
 // -------------------------
-// Collision Tracking Helpers
+// Collision Events
 // -------------------------
 
-// Helper to check if collider is already in collision list
-inline static bool IsInCollisionList(EC_Collider *collider, EC_Collider *other)
+inline static OnCollisionCallback EventCallback(EC_Collider *collider, CollisionEventType type)
 {
-    for (int i = 0; i < collider->currentCollisions_size; i++)
+    switch (type)
     {
-        if (collider->currentCollisions[i] == other)
-            return true;
+    case COLLISION_EVENT_ENTER:
+        return collider->OnCollisionEnter;
+    case COLLISION_EVENT_STAY:
+        return collider->OnCollisionStay;
+    case COLLISION_EVENT_EXIT:
+        return collider->OnCollisionExit;
+    default:
+        return NULL;
     }
-    return false;
 }
 
-// Helper to add collider to collision list
-inline static void AddToCollisionList(EC_Collider *collider, EC_Collider *other)
+/// @brief Append an event to the step's buffer, unless neither collider listens to its type
+static void PushCollisionEvent(CollisionEventType type, EC_Collider *colliderA, EC_Collider *colliderB,
+                               V3 contactPoint, V3 normal, float penetration)
 {
-    // Check if we need to expand capacity
-    if (collider->currentCollisions_size >= collider->currentCollisions_capacity)
+    if (!EventCallback(colliderA, type) && !EventCallback(colliderB, type))
+        return;
+    if (_manager->events_size >= _manager->events_capacity)
     {
-        collider->currentCollisions_capacity = (collider->currentCollisions_capacity == 0) ? 4 : collider->currentCollisions_capacity * 2;
-        collider->currentCollisions = realloc(collider->currentCollisions,
-                                              collider->currentCollisions_capacity * sizeof(EC_Collider *));
+        _manager->events_capacity = _manager->events_capacity == 0 ? 64 : _manager->events_capacity * 2;
+        _manager->events = realloc(_manager->events, sizeof(CollisionEvent) * _manager->events_capacity);
     }
+    _manager->events[_manager->events_size++] = (CollisionEvent){type, colliderA, colliderB, contactPoint, normal, penetration};
+}
 
-    collider->currentCollisions[collider->currentCollisions_size++] = other;
+/// @brief Run the callbacks of every recorded event in order, then clear the buffer
+static void DispatchCollisionEvents()
+{
+    // Callbacks may remove bodies, which turns their pending events into COLLISION_EVENT_NONE
+    for (size_t i = 0; i < _manager->events_size; i++)
+    {
+        CollisionEvent event = _manager->events[i];
+        if (event.type == COLLISION_EVENT_NONE)
+            continue;
+        OnCollisionCallback callbackA = EventCallback(event.colliderA, event.type);
+        if (callbackA)
+        {
+            CollisionInfo infoForA = {
+                .collider = event.colliderB,
+                .contactPoint = event.contactPoint,
+                .normal = V3_SCALE(event.normal, -1.0f), // Normal points away from A
+                .penetration = event.penetration};
+            callbackA(event.colliderA, &infoForA);
+        }
+        // Re-read, the first callback may have removed colliderB
+        if (_manager->events[i].type == COLLISION_EVENT_NONE)
+            continue;
+        OnCollisionCallback callbackB = EventCallback(event.colliderB, event.type);
+        if (callbackB)
+        {
+            CollisionInfo infoForB = {
+                .collider = event.colliderA,
+                .contactPoint = event.contactPoint,
+                .normal = event.normal, // Normal points away from B
+                .penetration = event.penetration};
+            callbackB(event.colliderB, &infoForB);
+        }
+    }
+    _manager->events_size = 0;
 }
 
-// Helper to remove collider from collision list
-inline static void RemoveFromCollisionList(EC_Collider *collider, EC_Collider *other)
+/// @brief Drop the pending events of a collider that is going away
+static void CancelCollisionEvents(EC_Collider *collider)
 {
-    for (int i = 0; i < collider->currentCollisions_size; i++)
+    for (size_t i = 0; i < _manager->events_size; i++)
     {
-        if (collider->currentCollisions[i] == other)
+        if (_manager->events[i].colliderA == collider || _manager->events[i].colliderB == collider)
         {
-            // Shift remaining elements
-            for (int j = i; j < collider->currentCollisions_size - 1; j++)
-            {
-                collider->currentCollisions[j] = collider->currentCollisions[j + 1];
-            }
-            collider->currentCollisions_size--;
-            return;
+            _manager->events[i].type = COLLISION_EVENT_NONE;
         }
     }
 }
 
 // -------------------------
-// Enhanced Collision Response with Events
+// Physics Thread
+// -------------------------
+
+/// @brief Block until the physics thread is done with the running step, the store is then safe to touch.
+/// Does not end the step: its poses and events stay pending until PhysicsManager_EndStep.
+static void WaitForStep(PhysicsManager *physicsManager)
+{
+    if (!physicsManager->stepInFlight)
+        return;
+    pthread_mutex_lock(&physicsManager->mutex);
+    while (physicsManager->stepPending)
+        pthread_cond_wait(&physicsManager->stepDone, &physicsManager->mutex);
+    pthread_mutex_unlock(&physicsManager->mutex);
+}
+
+// -------------------------
+// Snapshots
 // -------------------------
 
-static void HandleCollision(EC_RigidBody *bodyA, EC_RigidBody *bodyB, EC_Collider *colliderA, EC_Collider *colliderB)
+static void ReserveSnapshot(PhysicsSnapshot *snapshot, size_t size)
+{
+    if (size <= snapshot->capacity)
+        return;
+    snapshot->capacity = size;
+    snapshot->bodies = realloc(snapshot->bodies, sizeof(EC_RigidBody *) * size);
+    snapshot->positions = realloc(snapshot->positions, sizeof(V3) * size);
+    snapshot->rotations = realloc(snapshot->rotations, sizeof(Quaternion) * size);
+}
+
+static void FreeSnapshot(PhysicsSnapshot *snapshot)
+{
+    free(snapshot->bodies);
+    free(snapshot->positions);
+    free(snapshot->rotations);
+    memset(snapshot, 0, sizeof(PhysicsSnapshot));
+}
+
+/// @brief Copy the poses of the finished step into the older snapshot and make it the newest
+static void PublishSnapshot(PhysicsManager *physicsManager)
+{
+    RigidBodyStore *store = physicsManager->bodies;
+    physicsManager->currentSnapshot ^= 1;
+    PhysicsSnapshot *snapshot = &physicsManager->snapshots[physicsManager->currentSnapshot];
+    ReserveSnapshot(snapshot, store->size);
+    snapshot->size = store->size;
+    memcpy(snapshot->bodies, store->bodies, sizeof(EC_RigidBody *) * store->size);
+    memcpy(snapshot->positions, store->positions, sizeof(V3) * store->size);
+    memcpy(snapshot->rotations, store->rotations, sizeof(Quaternion) * store->size);
+}
+
+/// @brief Forget both snapshots, their indices no longer match after a body was added or removed.
+/// Bodies are drawn at their simulated pose until two more steps were published.
+static void InvalidateSnapshots(PhysicsManager *physicsManager)
+{
+    PhysicsManager_EndInterpolation(physicsManager);
+    physicsManager->snapshots[0].size = 0;
+    physicsManager->snapshots[1].size = 0;
+}
+
+inline static V3 LerpPosition(V3 a, V3 b, float t)
+{
+    return V3_ADD(a, V3_SCALE(V3_SUB(b, a), t));
+}
+
+/// @brief Normalized lerp along the shorter arc, close enough to a slerp over a single step
+inline static Quaternion LerpRotation(Quaternion a, Quaternion b, float t)
+{
+    float dot = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    float sign = dot < 0.0f ? -1.0f : 1.0f;
+    Quaternion q;
+    q.w = a.w + (sign * b.w - a.w) * t;
+    q.x = a.x + (sign * b.x - a.x) * t;
+    q.y = a.y + (sign * b.y - a.y) * t;
+    q.z = a.z + (sign * b.z - a.z) * t;
+    return Quat_Norm(q);
+}
+
+inline static bool SamePose(V3 positionA, Quaternion rotationA, V3 positionB, Quaternion rotationB)
+{
+    return positionA.x == positionB.x && positionA.y == positionB.y && positionA.z == positionB.z &&
+           rotationA.w == rotationB.w && rotationA.x == rotationB.x && rotationA.y == rotationB.y && rotationA.z == rotationB.z;
+}
+
+// -------------------------
+// Simulation Islands
+// -------------------------
+
+/// @brief Union-find forest over the store's indices, rebuilt every step from the touching pairs
+static struct
+{
+    size_t capacity;
+    uint32_t *parents;
+    float *minSleepTimers;
+    uint32_t *islandIds;
+} _islandScratch;
+
+/// @brief Last id handed to an island falling asleep, 0 is never used
+static uint32_t _sleepIsland = 0;
+
+/// @brief Moved by the solver: neither static nor kinematic
+inline static bool IsDynamic(uint8_t flags)
+{
+    return !(flags & (RIGIDBODY_STATIC | RIGIDBODY_KINEMATIC));
+}
+
+/// @brief Can push other bodies this step: neither static nor asleep
+inline static bool IsAwake(uint8_t flags)
+{
+    return !(flags & (RIGIDBODY_STATIC | RIGIDBODY_SLEEPING));
+}
+
+/// @brief Broadphase category of a body
+inline static SAPMotion MotionOf(uint8_t flags)
+{
+    if (flags & RIGIDBODY_STATIC)
+        return SAP_MOTION_STATIC;
+    if (flags & RIGIDBODY_KINEMATIC)
+        return SAP_MOTION_KINEMATIC;
+    return flags & RIGIDBODY_SLEEPING ? SAP_MOTION_SLEEPING : SAP_MOTION_DYNAMIC;
+}
+
+static void ResetIslands(size_t size)
+{
+    if (_islandScratch.capacity < size)
+    {
+        _islandScratch.capacity = size;
+        _islandScratch.parents = realloc(_islandScratch.parents, sizeof(uint32_t) * size);
+        _islandScratch.minSleepTimers = realloc(_islandScratch.minSleepTimers, sizeof(float) * size);
+        _islandScratch.islandIds = realloc(_islandScratch.islandIds, sizeof(uint32_t) * size);
+    }
+    for (size_t i = 0; i < size; i++)
+    {
+        _islandScratch.parents[i] = (uint32_t)i;
+    }
+}
+
+static uint32_t FindIsland(uint32_t i)
 {
-    // Wake up sleeping bodies
-    if (bodyA && bodyA->isSleeping)
+    uint32_t *parents = _islandScratch.parents;
+    while (parents[i] != i)
     {
-        bodyA->isSleeping = false;
-        bodyA->sleepTimer = 0.0f;
+        // Path halving
+        parents[i] = parents[parents[i]];
+        i = parents[i];
     }
-    if (bodyB && bodyB->isSleeping)
+    return i;
+}
+
+static void UnionIslands(uint32_t a, uint32_t b)
+{
+    a = FindIsland(a);
+    b = FindIsland(b);
+    if (a == b)
+        return;
+    // The lower index becomes the root, so islands do not depend on the order pairs are found in
+    if (a < b)
+        _islandScratch.parents[b] = a;
+    else
+        _islandScratch.parents[a] = b;
+}
+
+/// @brief Wake a sleeping body and every body that fell asleep in the same island
+static void WakeIsland(RigidBodyStore *store, uint32_t i)
+{
+    if (!(store->flags[i] & RIGIDBODY_SLEEPING))
+        return;
+    uint32_t island = store->sleepIslands[i];
+    for (size_t j = 0; j < store->size; j++)
     {
-        bodyB->isSleeping = false;
-        bodyB->sleepTimer = 0.0f;
+        if ((store->flags[j] & RIGIDBODY_SLEEPING) && store->sleepIslands[j] == island)
+        {
+            store->flags[j] &= ~RIGIDBODY_SLEEPING;
+            store->sleepTimers[j] = 0.0f;
+        }
     }
+}
 
-    AABB aabbA = colliderA->worldAABB;
-    AABB aabbB = colliderB->worldAABB;
+/// @brief Put every island whose members all rested for SLEEP_TIME_THRESHOLD to sleep at once
+static void SleepIslands(RigidBodyStore *store)
+{
+    float *minSleepTimers = _islandScratch.minSleepTimers;
+    uint32_t *islandIds = _islandScratch.islandIds;
+    for (size_t i = 0; i < store->size; i++)
+    {
+        minSleepTimers[i] = INFINITY;
+        islandIds[i] = 0;
+    }
+    for (size_t i = 0; i < store->size; i++)
+    {
+        if (IsDynamic(store->flags[i]) && IsAwake(store->flags[i]))
+        {
+            uint32_t root = FindIsland((uint32_t)i);
+            minSleepTimers[root] = fminf(minSleepTimers[root], store->sleepTimers[i]);
+        }
+    }
+    for (size_t i = 0; i < store->size; i++)
+    {
+        if (!IsDynamic(store->flags[i]) || !IsAwake(store->flags[i]))
+            continue;
+        uint32_t root = FindIsland((uint32_t)i);
+        if (minSleepTimers[root] < SLEEP_TIME_THRESHOLD)
+            continue;
+        if (islandIds[root] == 0)
+        {
+            islandIds[root] = ++_sleepIsland == 0 ? ++_sleepIsland : _sleepIsland;
+        }
+        store->flags[i] |= RIGIDBODY_SLEEPING;
+        store->sleepIslands[i] = islandIds[root];
+        store->velocities[i] = V3_ZERO;
+        store->angularVelocities[i] = V3_ZERO;
+    }
+}
+
+// -------------------------
+// Enhanced Collision Response
+// -------------------------
+
+/**
+ * @brief The bodies are still apart but would meet during this step. Remove just enough of their closing speed
+ * along the normal for them to end the step touching, instead of tunnelling through each other at low step rates.
+ * The regular response takes over once they overlap, so nothing bounces off a gap.
+ * @param gap Distance between the bounds along normal
+ */
+static void HandleSpeculativeContact(RigidBodyStore *store, uint32_t a, uint32_t b, V3 normal, float gap)
+{
+    float invMassA = IsDynamic(store->flags[a]) ? store->invMasses[a] : 0.0f;
+    float invMassB = IsDynamic(store->flags[b]) ? store->invMasses[b] : 0.0f;
+    float totalInvMass = invMassA + invMassB;
+    if (totalInvMass <= 0.0f)
+        return;
+
+    // Closing speed that still leaves the bodies apart, or just touching, at the end of the step
+    float allowedVelocity = -gap / _manager->timeStep;
+    float velocityAlongNormal = V3_DOT(V3_SUB(store->velocities[b], store->velocities[a]), normal);
+    if (velocityAlongNormal >= allowedVelocity)
+        return;
+
+    // Same island rules as a real contact, the body hit has to move with the one hitting it
+    if ((store->flags[a] & RIGIDBODY_SLEEPING) && IsAwake(store->flags[b]))
+        WakeIsland(store, a);
+    if ((store->flags[b] & RIGIDBODY_SLEEPING) && IsAwake(store->flags[a]))
+        WakeIsland(store, b);
+    if (IsDynamic(store->flags[a]) && IsDynamic(store->flags[b]))
+        UnionIslands(a, b);
+
+    V3 impulse = V3_SCALE(normal, (allowedVelocity - velocityAlongNormal) / totalInvMass);
+    if (invMassA > 0.0f)
+        store->velocities[a] = V3_SUB(store->velocities[a], V3_SCALE(impulse, invMassA));
+    if (invMassB > 0.0f)
+        store->velocities[b] = V3_ADD(store->velocities[b], V3_SCALE(impulse, invMassB));
+}
+
+/// @param a Index of the first body in the store
+/// @param b Index of the second body in the store
+static void HandleCollision(RigidBodyStore *store, uint32_t a, uint32_t b, EC_Collider *colliderA, EC_Collider *colliderB)
+{
+    // Kinematic bodies push dynamic ones around but are not pushed back
+    bool isStaticA = !IsDynamic(store->flags[a]);
+    bool isStaticB = !IsDynamic(store->flags[b]);
+
+    AABB aabbA = store->worldAABBs[a];
+    AABB aabbB = store->worldAABBs[b];
 
     V3 centerA = V3_SCALE(V3_ADD(aabbA.min, aabbA.max), 0.5f);
     V3 centerB = V3_SCALE(V3_ADD(aabbB.min, aabbB.max), 0.5f);
@@ -154,61 +435,35 @@ static void HandleCollision(EC_RigidBody *bodyA, EC_RigidBody *bodyB, EC_Collide
         contactPoint = (V3){(centerA.x + centerB.x) * 0.5f, (centerA.y + centerB.y) * 0.5f, contactZ};
     }
 
+    // Not touching yet, but the swept bounds overlapped
     if (penetration <= 0.0f)
-        return;
-
-    // === COLLISION EVENT HANDLING ===
-    bool wasCollidingA = IsInCollisionList(colliderA, colliderB);
-    bool wasCollidingB = IsInCollisionList(colliderB, colliderA);
-
-    // Prepare collision info for callbacks
-    CollisionInfo infoForA = {
-        .collider = colliderB,
-        .contactPoint = contactPoint,
-        .normal = V3_SCALE(normal, -1.0f), // Normal points away from A
-        .penetration = penetration};
-
-    CollisionInfo infoForB = {
-        .collider = colliderA,
-        .contactPoint = contactPoint,
-        .normal = normal, // Normal points away from B
-        .penetration = penetration};
-
-    // Fire OnCollisionEnter or OnCollisionStay
-    if (!wasCollidingA)
     {
-        AddToCollisionList(colliderA, colliderB);
-        if (colliderA->OnCollisionEnter)
-            colliderA->OnCollisionEnter(colliderA, &infoForA);
-    }
-    else
-    {
-        if (colliderA->OnCollisionStay)
-            colliderA->OnCollisionStay(colliderA, &infoForA);
+        HandleSpeculativeContact(store, a, b, normal, -penetration);
+        return;
     }
 
-    if (!wasCollidingB)
-    {
-        AddToCollisionList(colliderB, colliderA);
-        if (colliderB->OnCollisionEnter)
-            colliderB->OnCollisionEnter(colliderB, &infoForB);
-    }
-    else
-    {
-        if (colliderB->OnCollisionStay)
-            colliderB->OnCollisionStay(colliderB, &infoForB);
-    }
+    // === ISLANDS ===
+    // A body in motion wakes the island it runs into
+    if ((store->flags[a] & RIGIDBODY_SLEEPING) && IsAwake(store->flags[b]))
+        WakeIsland(store, a);
+    if ((store->flags[b] & RIGIDBODY_SLEEPING) && IsAwake(store->flags[a]))
+        WakeIsland(store, b);
+    // Dynamic bodies pushing on each other sleep and wake together
+    if (IsDynamic(store->flags[a]) && IsDynamic(store->flags[b]))
+        UnionIslands(a, b);
 
-    // === PHYSICS RESPONSE (skip if either is trigger) ===
-    if (colliderA->isTrigger || colliderB->isTrigger)
-        return;
+    // === COLLISION EVENT HANDLING ===
+    bool wasColliding = ContactCache_Touch(_manager->contacts, store->handles[a], store->handles[b], colliderA, colliderB);
+
+    // Callbacks run once the step is done, record the event for now
+    PushCollisionEvent(wasColliding ? COLLISION_EVENT_STAY : COLLISION_EVENT_ENTER, colliderA, colliderB,
+                       contactPoint, normal, penetration);
 
-    float massA = (*colliderA->isStatic || bodyA->mass <= 0) ? 0.0f : bodyA->mass;
-    float massB = (*colliderB->isStatic || bodyB->mass <= 0) ? 0.0f : bodyB->mass;
+    // === PHYSICS RESPONSE ===
 
     // Calculate inverse masses
-    float invMassA = (massA > 0.0f) ? 1.0f / massA : 0.0f;
-    float invMassB = (massB > 0.0f) ? 1.0f / massB : 0.0f;
+    float invMassA = isStaticA ? 0.0f : store->invMasses[a];
+    float invMassB = isStaticB ? 0.0f : store->invMasses[b];
     float totalInvMass = invMassA + invMassB;
 
     if (totalInvMass <= 0.0f)
@@ -218,18 +473,18 @@ static void HandleCollision(EC_RigidBody *bodyA, EC_RigidBody *bodyB, EC_Collide
     float correctionAmount = fmaxf(penetration - PENETRATION_ALLOWANCE, 0.0f) * PENETRATION_CORRECTION;
     V3 correction = V3_SCALE(normal, correctionAmount);
 
-    if (!*colliderA->isStatic)
+    if (!isStaticA)
     {
-        Transform *transformA = &bodyA->component->entity->transform;
         V3 correctionA = V3_SCALE(correction, -invMassA / totalInvMass);
-        T_LPos_Add(transformA, correctionA);
+        store->positions[a] = V3_ADD(store->positions[a], correctionA);
+        store->flags[a] |= RIGIDBODY_MOVED;
     }
 
-    if (!*colliderB->isStatic)
+    if (!isStaticB)
     {
-        Transform *transformB = &bodyB->component->entity->transform;
         V3 correctionB = V3_SCALE(correction, invMassB / totalInvMass);
-        T_LPos_Add(transformB, correctionB);
+        store->positions[b] = V3_ADD(store->positions[b], correctionB);
+        store->flags[b] |= RIGIDBODY_MOVED;
     }
 
     // ===== CALCULATE CONTACT POINT RELATIVE TO CENTER OF MASS =====
@@ -238,18 +493,18 @@ static void HandleCollision(EC_RigidBody *bodyA, EC_RigidBody *bodyB, EC_Collide
 
     // ===== CALCULATE RELATIVE VELOCITY AT CONTACT POINT =====
     // For rigid body: velocity_at_point = linear_velocity + (angular_velocity × r)
-    V3 velocityA = bodyA->velocity;
-    V3 velocityB = bodyB->velocity;
+    V3 velocityA = store->velocities[a];
+    V3 velocityB = store->velocities[b];
 
-    if (!*colliderA->isStatic)
+    if (!isStaticA)
     {
-        V3 rotationalVelA = V3_CROSS(bodyA->angularVelocity, rA);
+        V3 rotationalVelA = V3_CROSS(store->angularVelocities[a], rA);
         velocityA = V3_ADD(velocityA, rotationalVelA);
     }
 
-    if (!*colliderB->isStatic)
+    if (!isStaticB)
     {
-        V3 rotationalVelB = V3_CROSS(bodyB->angularVelocity, rB);
+        V3 rotationalVelB = V3_CROSS(store->angularVelocities[b], rB);
         velocityB = V3_ADD(velocityB, rotationalVelB);
     }
 
@@ -268,23 +523,23 @@ static void HandleCollision(EC_RigidBody *bodyA, EC_RigidBody *bodyB, EC_Collide
     V3 invInertiaA = V3_ZERO;
     V3 invInertiaB = V3_ZERO;
 
-    if (!*colliderA->isStatic && massA > 0.0f)
+    if (invMassA > 0.0f)
     {
         float sizeSquared = (sizeA.x * sizeA.x + sizeA.y * sizeA.y + sizeA.z * sizeA.z) / 6.0f;
-        float inertia = massA * sizeSquared;
-        if (inertia > 0.0f)
+        if (sizeSquared > 0.0f)
         {
-            invInertiaA = (V3){1.0f / inertia, 1.0f / inertia, 1.0f / inertia};
+            float invInertia = invMassA / sizeSquared;
+            invInertiaA = (V3){invInertia, invInertia, invInertia};
         }
     }
 
-    if (!*colliderB->isStatic && massB > 0.0f)
+    if (invMassB > 0.0f)
     {
         float sizeSquared = (sizeB.x * sizeB.x + sizeB.y * sizeB.y + sizeB.z * sizeB.z) / 6.0f;
-        float inertia = massB * sizeSquared;
-        if (inertia > 0.0f)
+        if (sizeSquared > 0.0f)
         {
-            invInertiaB = (V3){1.0f / inertia, 1.0f / inertia, 1.0f / inertia};
+            float invInertia = invMassB / sizeSquared;
+            invInertiaB = (V3){invInertia, invInertia, invInertia};
         }
     }
 
@@ -304,44 +559,44 @@ static void HandleCollision(EC_RigidBody *bodyA, EC_RigidBody *bodyB, EC_Collide
     V3 impulse = V3_SCALE(normal, impulseMagnitude);
 
     // ===== APPLY LINEAR AND ANGULAR IMPULSES =====
-    if (!*colliderA->isStatic)
+    if (!isStaticA)
     {
         // Apply linear impulse
-        bodyA->velocity = V3_SUB(bodyA->velocity, V3_SCALE(impulse, invMassA));
+        store->velocities[a] = V3_SUB(store->velocities[a], V3_SCALE(impulse, invMassA));
 
         // Apply angular impulse: Δω = I⁻¹ * (r × impulse)
         V3 torqueImpulse = V3_CROSS(rA, V3_SCALE(impulse, -1.0f));
         V3 angularImpulse = V3_MUL(torqueImpulse, invInertiaA);
-        bodyA->angularVelocity = V3_ADD(bodyA->angularVelocity, angularImpulse);
+        store->angularVelocities[a] = V3_ADD(store->angularVelocities[a], angularImpulse);
 
         // Clamp very small velocities to zero
-        if (V3_MAGNITUDE(bodyA->velocity) < SLEEP_VELOCITY_THRESHOLD)
+        if (V3_MAGNITUDE(store->velocities[a]) < SLEEP_VELOCITY_THRESHOLD)
         {
-            bodyA->velocity = V3_ZERO;
+            store->velocities[a] = V3_ZERO;
         }
-        if (V3_MAGNITUDE(bodyA->angularVelocity) < SLEEP_ANGULAR_THRESHOLD)
+        if (V3_MAGNITUDE(store->angularVelocities[a]) < SLEEP_ANGULAR_THRESHOLD)
         {
-            bodyA->angularVelocity = V3_ZERO;
+            store->angularVelocities[a] = V3_ZERO;
         }
     }
 
-    if (!*colliderB->isStatic)
+    if (!isStaticB)
     {
         // Apply linear impulse
-        bodyB->velocity = V3_ADD(bodyB->velocity, V3_SCALE(impulse, invMassB));
+        store->velocities[b] = V3_ADD(store->velocities[b], V3_SCALE(impulse, invMassB));
 
         // Apply angular impulse
         V3 torqueImpulse = V3_CROSS(rB, impulse);
         V3 angularImpulse = V3_MUL(torqueImpulse, invInertiaB);
-        bodyB->angularVelocity = V3_ADD(bodyB->angularVelocity, angularImpulse);
+        store->angularVelocities[b] = V3_ADD(store->angularVelocities[b], angularImpulse);
 
-        if (V3_MAGNITUDE(bodyB->velocity) < SLEEP_VELOCITY_THRESHOLD)
+        if (V3_MAGNITUDE(store->velocities[b]) < SLEEP_VELOCITY_THRESHOLD)
         {
-            bodyB->velocity = V3_ZERO;
+            store->velocities[b] = V3_ZERO;
         }
-        if (V3_MAGNITUDE(bodyB->angularVelocity) < SLEEP_ANGULAR_THRESHOLD)
+        if (V3_MAGNITUDE(store->angularVelocities[b]) < SLEEP_ANGULAR_THRESHOLD)
         {
-            bodyB->angularVelocity = V3_ZERO;
+            store->angularVelocities[b] = V3_ZERO;
         }
     }
 
@@ -375,17 +630,17 @@ static void HandleCollision(EC_RigidBody *bodyA, EC_RigidBody *bodyB, EC_Collide
         V3 frictionImpulse = V3_SCALE(tangent, frictionMagnitude);
 
         // Apply friction impulses
-        if (!*colliderA->isStatic)
+        if (!isStaticA)
         {
-            bodyA->velocity = V3_SUB(bodyA->velocity, V3_SCALE(frictionImpulse, invMassA));
+            store->velocities[a] = V3_SUB(store->velocities[a], V3_SCALE(frictionImpulse, invMassA));
             V3 frictionTorque = V3_CROSS(rA, V3_SCALE(frictionImpulse, -1.0f));
-            bodyA->angularVelocity = V3_ADD(bodyA->angularVelocity, V3_MUL(frictionTorque, invInertiaA));
+            store->angularVelocities[a] = V3_ADD(store->angularVelocities[a], V3_MUL(frictionTorque, invInertiaA));
         }
-        if (!*colliderB->isStatic)
+        if (!isStaticB)
         {
-            bodyB->velocity = V3_ADD(bodyB->velocity, V3_SCALE(frictionImpulse, invMassB));
+            store->velocities[b] = V3_ADD(store->velocities[b], V3_SCALE(frictionImpulse, invMassB));
             V3 frictionTorque = V3_CROSS(rB, frictionImpulse);
-            bodyB->angularVelocity = V3_ADD(bodyB->angularVelocity, V3_MUL(frictionTorque, invInertiaB));
+            store->angularVelocities[b] = V3_ADD(store->angularVelocities[b], V3_MUL(frictionTorque, invInertiaB));
         }
     }
 }
@@ -401,6 +656,16 @@ inline static bool AABB_Overlap(AABB a, AABB b)
            (a.min.z <= b.max.z && a.max.z >= b.min.z);
 }
 
+/// @brief Bounds covering the body over the whole step, from where it is now to where velocity takes it
+inline static AABB SweptAABB(AABB aabb, V3 velocity, float deltaTime)
+{
+    V3 displacement = V3_SCALE(velocity, deltaTime);
+    AABB swept = aabb;
+    swept.min = V3_ADD(swept.min, V3_MIN(displacement, V3_ZERO));
+    swept.max = V3_ADD(swept.max, V3_MAX(displacement, V3_ZERO));
+    return swept;
+}
+
 inline static void UpdateWorldAABB(EC_Collider *collider)
 {
     if (!collider || !collider->transform)
@@ -458,150 +723,362 @@ inline static void UpdateWorldAABB(EC_Collider *collider)
     }
 }
 
+inline static uint32_t LayerBit(uint8_t layer)
+{
+    return 1u << layer;
+}
+
+inline static uint32_t LayerCollisionMask(uint8_t layer)
+{
+    return COLLISION_MASK[layer];
+}
+
+/// @brief Layers a ray may hit this collider through, 0 when its layer is not raycastable
+inline static uint32_t LayerRaycastMask(uint8_t layer)
+{
+    uint32_t mask = LayerCollisionMask(layer);
+    return (mask & (1u << E_LAYER_RAYCAST)) ? mask : 0u;
+}
+
+/// @brief Whether the body's world bounds follow its transform
+inline static bool HasMovingProxy(EC_RigidBody *ec_rigidbody)
+{
+    return ec_rigidbody->ec_collider && ec_rigidbody->overlapProxy != SPATIAL_HASH_NONE && !*ec_rigidbody->isStatic;
+}
+
 inline static void BroadPhase()
 {
-    EC_RigidBody *ec_rigidbody = NULL;
-    for (int i = 0; i < _manager->rigidbodies_size; i++)
+    // The broadphase structures are not thread-safe, feed them the new bounds in order
+    RigidBodyStore *store = _manager->bodies;
+    for (size_t i = 0; i < store->size; i++)
     {
-        if (!_manager->rigidbodies[i])
+        EC_RigidBody *ec_rigidbody = store->bodies[i];
+        if (ec_rigidbody->broadphaseProxy == SAP_PROXY_NONE)
         {
             continue;
         }
-        ec_rigidbody = _manager->rigidbodies[i];
-        if (!*ec_rigidbody->isStatic)
+        uint8_t layer = store->layers[i];
+        uint8_t flags = store->flags[i];
+        if (flags & RIGIDBODY_SLEEPING)
         {
-            UpdateWorldAABB(ec_rigidbody->ec_collider);
+            // Sleeping bodies do not move. Hand them to the broadphase as sleeping once, so it only pairs them
+            // with what can wake them, and skip them until they wake up.
+            if (!(flags & RIGIDBODY_PROXY_ASLEEP))
+            {
+                store->flags[i] = flags | RIGIDBODY_PROXY_ASLEEP;
+                SweepAndPrune_UpdateProxy(_manager->broadphase, ec_rigidbody->broadphaseProxy, store->worldAABBs[i],
+                                          LayerBit(layer), LayerCollisionMask(layer), MotionOf(flags));
+            }
+            continue;
         }
+        store->flags[i] = flags & ~RIGIDBODY_PROXY_ASLEEP;
+        // Pair moving bodies with everything they could reach this step, not only what they already overlap
+        AABB bounds = IsDynamic(flags) ? SweptAABB(store->worldAABBs[i], store->velocities[i], _manager->timeStep) : store->worldAABBs[i];
+        // Layer, static and kinematic flags can change after registration, refresh them with the bounds.
+        // Kinematic bodies move through the static world on their own, they only meet dynamic and sleeping bodies.
+        SweepAndPrune_UpdateProxy(_manager->broadphase, ec_rigidbody->broadphaseProxy, bounds,
+                                  LayerBit(layer), LayerCollisionMask(layer), MotionOf(flags));
     }
+    SweepAndPrune_Update(_manager->broadphase);
 }
 
-inline static void DetectCollisionExits()
+/// @brief Feed the new bounds to the raycast tree and the overlap grid. Runs on the main thread with PullState,
+/// so queries never see the structures mid-update while the physics thread solves the step.
+static void UpdateQueryProxies(RigidBodyStore *store)
 {
-    // Check all colliders for collisions that have ended
-    for (int i = 0; i < _manager->rigidbodies_size; i++)
+    for (size_t i = 0; i < store->size; i++)
     {
-        if (!_manager->rigidbodies[i])
+        EC_RigidBody *ec_rigidbody = store->bodies[i];
+        if (ec_rigidbody->overlapProxy == SPATIAL_HASH_NONE || (store->flags[i] & RIGIDBODY_SLEEPING))
             continue;
+        uint8_t layer = store->layers[i];
+        SceneBVH_UpdateItem(_manager->raycastTree, ec_rigidbody->raycastProxy, store->worldAABBs[i], LayerRaycastMask(layer));
+        SpatialHash_Update(_manager->overlapGrid, ec_rigidbody->overlapProxy, store->worldAABBs[i], layer);
+    }
+    SceneBVH_Update(_manager->raycastTree);
+}
 
-        EC_RigidBody *bodyA = _manager->rigidbodies[i];
-        EC_Collider *colliderA = bodyA->ec_collider;
-        if (!colliderA)
-            continue;
+/// @brief Record OnCollisionExit for a pair that stopped touching
+static bool OnContactEnded(void *context, uint32_t bodyA, uint32_t bodyB, EC_Collider *colliderA, EC_Collider *colliderB)
+{
+    RigidBodyStore *store = _manager->bodies;
+    uint8_t flagsA = store->flags[RigidBodyStore_Index(store, bodyA)];
+    uint8_t flagsB = store->flags[RigidBodyStore_Index(store, bodyB)];
+    // The broadphase stops testing a sleeping body against the ones that cannot wake it, but nothing moved them
+    // apart. Pairs with a kinematic or dynamic body are still tested, missing them means they separated.
+    if (((flagsA | flagsB) & RIGIDBODY_SLEEPING) && !SweepAndPrune_MotionsPair(MotionOf(flagsA), MotionOf(flagsB)))
+        return false;
+    PushCollisionEvent(COLLISION_EVENT_EXIT, colliderA, colliderB, V3_ZERO, V3_ZERO, 0.0f);
+    return true;
+}
 
-        // Check each collision in the list
-        for (int j = 0; j < colliderA->currentCollisions_size; j++)
-        {
-            EC_Collider *colliderB = colliderA->currentCollisions[j];
+inline static void NarrowPhase()
+{
+    // Only pairs whose AABBs overlap and whose layers collide reach the detailed test
+    SweepAndPrune *broadphase = _manager->broadphase;
+    RigidBodyStore *store = _manager->bodies;
+    size_t pairs_size = SweepAndPrune_FindPairs(broadphase);
+    ContactCache_BeginStep(_manager->contacts);
+    for (size_t i = 0; i < pairs_size; i++)
+    {
+        EC_RigidBody *bodyA = broadphase->proxies[broadphase->pairs[i].proxyA].rigidbody;
+        EC_RigidBody *bodyB = broadphase->proxies[broadphase->pairs[i].proxyB].rigidbody;
+        HandleCollision(store, RigidBodyStore_Index(store, bodyA->handle), RigidBodyStore_Index(store, bodyB->handle),
+                        bodyA->ec_collider, bodyB->ec_collider);
+    }
 
-            // Check if they're still colliding
-            if (!AABB_Overlap(colliderA->worldAABB, colliderB->worldAABB))
-            {
-                // Collision ended - fire OnCollisionExit
-                if (colliderA->OnCollisionExit)
-                {
-                    CollisionInfo info = {
-                        .collider = colliderB,
-                        .contactPoint = V3_ZERO,
-                        .normal = V3_ZERO,
-                        .penetration = 0.0f};
-                    colliderA->OnCollisionExit(colliderA, &info);
-                }
-
-                // Remove from list
-                RemoveFromCollisionList(colliderA, colliderB);
-                j--; // Adjust index since we removed an element
-            }
+    // Pairs that touched last step but not in this one
+    ContactCache_EndStep(_manager->contacts, OnContactEnded, NULL);
+}
+
+// -------------------------
+// Triggers
+// -------------------------
+
+typedef struct TriggerQuery
+{
+    /// @brief Handle of the trigger's body
+    uint32_t body;
+    EC_Collider *collider;
+    AABB bounds;
+    uint8_t layer;
+    bool isStatic;
+} TriggerQuery;
+
+static void AddTrigger(uint32_t body)
+{
+    if (_manager->triggers_size >= _manager->triggers_capacity)
+    {
+        _manager->triggers_capacity = _manager->triggers_capacity == 0 ? 16 : _manager->triggers_capacity * 2;
+        _manager->triggers = realloc(_manager->triggers, sizeof(uint32_t) * _manager->triggers_capacity);
+    }
+    _manager->triggers[_manager->triggers_size++] = body;
+}
+
+static void RemoveTrigger(uint32_t body)
+{
+    for (size_t i = 0; i < _manager->triggers_size; i++)
+    {
+        if (_manager->triggers[i] == body)
+        {
+            _manager->triggers[i] = _manager->triggers[--_manager->triggers_size];
+            return;
         }
     }
 }
 
-inline static void NarrowPhase()
+/// @brief Record OnCollisionEnter for a collider that started overlapping a trigger
+static bool CollectTriggerOverlap(void *context, EC_Collider *collider, AABB bounds)
+{
+    TriggerQuery *query = context;
+    if (collider == query->collider || (query->isStatic && *collider->isStatic) || !AABB_Overlap(bounds, query->bounds))
+        return true;
+    Entity *entity = collider->component->entity;
+    if (!(LayerCollisionMask(entity->layer) & LayerBit(query->layer)))
+        return true;
+    Component *component = Entity_GetComponent(entity, EC_T_RIGIDBODY);
+    if (!component)
+        return true;
+    EC_RigidBody *other = component->self;
+    // Two overlapping triggers find each other, the second lookup sees the pair already touching
+    if (!ContactCache_Touch(_manager->triggerContacts, query->body, other->handle, query->collider, collider))
+    {
+        V3 contactPoint = V3_CENTER(V3_MAX(bounds.min, query->bounds.min), V3_MIN(bounds.max, query->bounds.max));
+        PushCollisionEvent(COLLISION_EVENT_ENTER, query->collider, collider, contactPoint, V3_ZERO, 0.0f);
+    }
+    return true;
+}
+
+/// @brief Record OnCollisionExit for a collider that left a trigger
+static bool OnTriggerEnded(void *context, uint32_t bodyA, uint32_t bodyB, EC_Collider *colliderA, EC_Collider *colliderB)
 {
-    // Perform detailed collision detection between overlapping AABBs
-    for (int i = 0; i < _manager->rigidbodies_size; i++)
+    PushCollisionEvent(COLLISION_EVENT_EXIT, colliderA, colliderB, V3_ZERO, V3_ZERO, 0.0f);
+    return true;
+}
+
+/**
+ * @brief Look every trigger up in the overlap grid and report the colliders that entered or left it.
+ * No contact is solved and nothing is woken up, so a trigger costs one grid query per step.
+ * Runs on the main thread, which owns the overlap grid, against the bounds the step was solved with.
+ */
+static void DetectTriggerOverlaps(PhysicsManager *physicsManager)
+{
+    RigidBodyStore *store = physicsManager->bodies;
+    ContactCache_BeginStep(physicsManager->triggerContacts);
+    for (size_t t = 0; t < physicsManager->triggers_size; t++)
     {
-        if (!_manager->rigidbodies[i])
-            continue;
+        uint32_t i = RigidBodyStore_Index(store, physicsManager->triggers[t]);
+        TriggerQuery query = {physicsManager->triggers[t], store->bodies[i]->ec_collider, store->worldAABBs[i], store->layers[i],
+                              store->flags[i] & RIGIDBODY_STATIC};
+        SpatialHash_Query(physicsManager->overlapGrid, query.bounds, LayerCollisionMask(query.layer), CollectTriggerOverlap, &query);
+    }
+    ContactCache_EndStep(physicsManager->triggerContacts, OnTriggerEnded, NULL);
+}
 
-        EC_RigidBody *bodyA = _manager->rigidbodies[i];
-        EC_Collider *colliderA = bodyA->ec_collider;
-        if (!colliderA)
-            continue;
+// -------------------------
+// Commands
+// -------------------------
+
+/// @brief Index of a registered body that forces and velocities apply to, its island is woken up since they are about to change
+/// @return false for unregistered, static and kinematic bodies
+static bool GetDynamicIndex(EC_RigidBody *ec_rigidbody, uint32_t *outIndex)
+{
+    if (!ec_rigidbody || ec_rigidbody->handle == RIGIDBODY_HANDLE_NONE || *ec_rigidbody->isStatic)
+        return false;
+    *outIndex = RigidBodyStore_Index(_manager->bodies, ec_rigidbody->handle);
+    if (_manager->bodies->flags[*outIndex] & RIGIDBODY_KINEMATIC)
+        return false;
+    WakeIsland(_manager->bodies, *outIndex);
+    return true;
+}
 
-        for (int j = i + 1; j < _manager->rigidbodies_size; j++)
+/// @brief Queue a write for the start of the next step, the physics thread may be reading the store right now
+static void QueueCommand(EC_RigidBody *ec_rigidbody, PhysicsCommandType type, V3 value)
+{
+    if (!ec_rigidbody || ec_rigidbody->handle == RIGIDBODY_HANDLE_NONE || *ec_rigidbody->isStatic)
+        return;
+    if (_manager->commands_size >= _manager->commands_capacity)
+    {
+        _manager->commands_capacity = _manager->commands_capacity == 0 ? 64 : _manager->commands_capacity * 2;
+        _manager->commands = realloc(_manager->commands, sizeof(PhysicsCommand) * _manager->commands_capacity);
+    }
+    _manager->commands[_manager->commands_size++] = (PhysicsCommand){type, ec_rigidbody->handle, value};
+}
+
+/// @brief Apply the queued writes in the order they were made, then clear the queue
+static void ApplyCommands(RigidBodyStore *store)
+{
+    for (size_t c = 0; c < _manager->commands_size; c++)
+    {
+        PhysicsCommand command = _manager->commands[c];
+        if (command.type == PHYSICS_COMMAND_NONE)
+            continue;
+        uint32_t i;
+        if (!GetDynamicIndex(store->bodies[RigidBodyStore_Index(store, command.body)], &i))
+            continue;
+        switch (command.type)
         {
-            if (!_manager->rigidbodies[j])
-                continue;
-
-            EC_RigidBody *bodyB = _manager->rigidbodies[j];
-            EC_Collider *colliderB = bodyB->ec_collider;
-            if (!colliderB)
-                continue;
-            // Skip if both bodies are static
-            if (*colliderA->isStatic && *colliderB->isStatic)
-                continue;
-            // Skip if layers do not collide
-            if (!(COLLISION_MASK[colliderA->component->entity->layer] & (1 << colliderB->component->entity->layer)))
-                continue;
-
-            // Check for AABB overlap first
-            if (AABB_Overlap(colliderA->worldAABB, colliderB->worldAABB))
-            {
-                // Only log collision once per second to avoid spam
-                static float lastLogTime = 0.0f;
-                static float currentTime = 0.0f;
-                currentTime += 0.016f; // Approximate frame time
-
-                if (currentTime - lastLogTime > 1.0f)
-                {
-                    // Log(&_logConfig, "Collision detected between %s and %s",
-                    //     colliderA->component->entity->name,
-                    //     colliderB->component->entity->name);
-                    lastLogTime = currentTime;
-                }
-
-                // Generate collision response
-                HandleCollision(bodyA, bodyB, colliderA, colliderB);
-            }
+        case PHYSICS_COMMAND_ADD_FORCE:
+            store->forces[i] = V3_ADD(store->forces[i], command.value);
+            break;
+        case PHYSICS_COMMAND_ADD_TORQUE:
+            store->torques[i] = V3_ADD(store->torques[i], command.value);
+            break;
+        case PHYSICS_COMMAND_SET_VELOCITY:
+            store->velocities[i] = command.value;
+            break;
+        case PHYSICS_COMMAND_SET_ANGULAR_VELOCITY:
+            store->angularVelocities[i] = command.value;
+            break;
+        default:
+            break;
         }
     }
+    _manager->commands_size = 0;
+}
 
-    // Detect collision exits for all rigidbodies
-    DetectCollisionExits();
+/// @brief Drop the queued writes of a body that is going away, before its handle gets reused
+static void CancelCommands(uint32_t body)
+{
+    for (size_t i = 0; i < _manager->commands_size; i++)
+    {
+        if (_manager->commands[i].body == body)
+        {
+            _manager->commands[i].type = PHYSICS_COMMAND_NONE;
+        }
+    }
 }
 
 // -------------------------
 // Management
 // -------------------------
 
-void PhysicsManager_RegisterRigidBody(EC_RigidBody *ec_rigidbody)
+static void AddBroadphaseProxy(EC_RigidBody *ec_rigidbody)
 {
-    for (int i = 0; i < _manager->rigidbodies_size; i++)
+    EC_Collider *collider = ec_rigidbody->ec_collider;
+    if (!collider)
+        return;
+    // Static colliders computed their bounds on creation, the others have not been updated yet
+    if (!*ec_rigidbody->isStatic)
+    {
+        UpdateWorldAABB(collider);
+    }
+    uint8_t layer = collider->component->entity->layer;
+    // Triggers only report overlaps, they stay out of the solver's pairs and are looked up in the overlap grid instead
+    if (!collider->isTrigger)
     {
-        if (_manager->rigidbodies[i] == NULL)
+        ec_rigidbody->broadphaseProxy = SweepAndPrune_AddProxy(_manager->broadphase, ec_rigidbody, collider->worldAABB,
+                                                               LayerBit(layer), LayerCollisionMask(layer),
+                                                               *ec_rigidbody->isStatic ? SAP_MOTION_STATIC : SAP_MOTION_DYNAMIC);
+    }
+    ec_rigidbody->raycastProxy = SceneBVH_Insert(_manager->raycastTree, collider, collider->worldAABB, LayerRaycastMask(layer));
+    ec_rigidbody->overlapProxy = SpatialHash_Insert(_manager->overlapGrid, collider, collider->worldAABB, layer);
+}
+
+void PhysicsManager_RegisterRigidBody(EC_RigidBody *ec_rigidbody, float mass, bool useGravity, RigidBodyConstraints constraints)
+{
+    WaitForStep(_manager);
+    InvalidateSnapshots(_manager);
+    AddBroadphaseProxy(ec_rigidbody);
+    RigidBodyStore *store = _manager->bodies;
+    ec_rigidbody->handle = RigidBodyStore_Add(store, ec_rigidbody);
+    uint32_t i = RigidBodyStore_Index(store, ec_rigidbody->handle);
+    Entity *entity = ec_rigidbody->component->entity;
+    store->positions[i] = T_LPos(&entity->transform);
+    store->rotations[i] = T_LRot(&entity->transform);
+    store->invMasses[i] = mass > 0.0f ? 1.0f / mass : 0.0f;
+    store->linearDampings[i] = 0.5f;  // Increased from 0.1f for better stability
+    store->angularDampings[i] = 0.5f; // Increased from 0.1f for better stability
+    store->constraints[i] = constraints;
+    store->flags[i] = (useGravity ? RIGIDBODY_GRAVITY : 0) | (*ec_rigidbody->isStatic ? RIGIDBODY_STATIC : 0);
+    store->layers[i] = entity->layer;
+    if (ec_rigidbody->ec_collider)
+    {
+        store->worldAABBs[i] = ec_rigidbody->ec_collider->worldAABB;
+        if (ec_rigidbody->ec_collider->isTrigger)
         {
-            _manager->rigidbodies[i] = ec_rigidbody;
-            LogSuccess(&_logConfig, "Registered Rigidbody. Total Rigidbodies: %d", _manager->rigidbodies_size);
-            return;
+            AddTrigger(ec_rigidbody->handle);
         }
     }
-    _manager->rigidbodies_size++;
-    _manager->rigidbodies = realloc(_manager->rigidbodies, sizeof(EC_RigidBody *) * _manager->rigidbodies_size);
-    _manager->rigidbodies[_manager->rigidbodies_size - 1] = ec_rigidbody;
-    LogSuccess(&_logConfig, "Registered Rigidbody. Total Rigidbodies: %d", _manager->rigidbodies_size);
+    LogSuccess(&_logConfig, "Registered Rigidbody. Total Rigidbodies: %zu", store->size);
 }
 
 void PhysicsManager_RemoveRigidBody(EC_RigidBody *ec_rigidbody)
 {
-    for (int i = 0; i < _manager->rigidbodies_size; i++)
+    if (ec_rigidbody->handle == RIGIDBODY_HANDLE_NONE)
     {
-        if (_manager->rigidbodies[i] == ec_rigidbody)
-        {
-            _manager->rigidbodies[i] = NULL;
-            return;
-        }
+        LogWarning(&_logConfig, "Failed to remove Rigidbody (%s), not found.", ec_rigidbody->component->entity->name);
+        return;
+    }
+    WaitForStep(_manager);
+    InvalidateSnapshots(_manager);
+    // Whatever rested on the body has to notice it is gone
+    WakeIsland(_manager->bodies, RigidBodyStore_Index(_manager->bodies, ec_rigidbody->handle));
+    ContactCache_RemoveBody(_manager->contacts, ec_rigidbody->handle);
+    ContactCache_RemoveBody(_manager->triggerContacts, ec_rigidbody->handle);
+    RemoveTrigger(ec_rigidbody->handle);
+    if (ec_rigidbody->ec_collider)
+    {
+        CancelCollisionEvents(ec_rigidbody->ec_collider);
+    }
+    CancelCommands(ec_rigidbody->handle);
+    RigidBodyStore_Remove(_manager->bodies, ec_rigidbody->handle);
+    ec_rigidbody->handle = RIGIDBODY_HANDLE_NONE;
+    if (ec_rigidbody->broadphaseProxy != SAP_PROXY_NONE)
+    {
+        SweepAndPrune_RemoveProxy(_manager->broadphase, ec_rigidbody->broadphaseProxy);
+        ec_rigidbody->broadphaseProxy = SAP_PROXY_NONE;
+    }
+    if (ec_rigidbody->raycastProxy != SCENE_BVH_NONE)
+    {
+        SceneBVH_Remove(_manager->raycastTree, ec_rigidbody->raycastProxy);
+        ec_rigidbody->raycastProxy = SCENE_BVH_NONE;
+    }
+    if (ec_rigidbody->overlapProxy != SPATIAL_HASH_NONE)
+    {
+        SpatialHash_Remove(_manager->overlapGrid, ec_rigidbody->overlapProxy);
+        ec_rigidbody->overlapProxy = SPATIAL_HASH_NONE;
     }
-    LogWarning(&_logConfig, "Failed to remove Rigidbody (%s), not found.", ec_rigidbody->component->entity->name);
 }
 
 // -------------------------
@@ -610,34 +1087,59 @@ void PhysicsManager_RemoveRigidBody(EC_RigidBody *ec_rigidbody)
 
 void PhysicsManager_AddForce(EC_RigidBody *ec_rigidbody, V3 force)
 {
-    if (!ec_rigidbody || ec_rigidbody->isKinematic || *ec_rigidbody->isStatic)
-        return;
-
-    ec_rigidbody->forceAccum = V3_ADD(ec_rigidbody->forceAccum, force);
+    QueueCommand(ec_rigidbody, PHYSICS_COMMAND_ADD_FORCE, force);
 }
 
 void PhysicsManager_AddTorque(EC_RigidBody *ec_rigidbody, V3 torque)
 {
-    if (!ec_rigidbody || ec_rigidbody->isKinematic || *ec_rigidbody->isStatic)
-        return;
-
-    ec_rigidbody->torqueAccum = V3_ADD(ec_rigidbody->torqueAccum, torque);
+    QueueCommand(ec_rigidbody, PHYSICS_COMMAND_ADD_TORQUE, torque);
 }
 
 void PhysicsManager_SetVelocity(EC_RigidBody *ec_rigidbody, V3 velocity)
 {
-    if (!ec_rigidbody || ec_rigidbody->isKinematic || *ec_rigidbody->isStatic)
-        return;
-
-    ec_rigidbody->velocity = velocity;
+    QueueCommand(ec_rigidbody, PHYSICS_COMMAND_SET_VELOCITY, velocity);
 }
 
 void PhysicsManager_SetAngularVelocity(EC_RigidBody *ec_rigidbody, V3 angularVelocity)
 {
-    if (!ec_rigidbody || ec_rigidbody->isKinematic || *ec_rigidbody->isStatic)
+    QueueCommand(ec_rigidbody, PHYSICS_COMMAND_SET_ANGULAR_VELOCITY, angularVelocity);
+}
+
+void PhysicsManager_SetKinematic(EC_RigidBody *ec_rigidbody, bool isKinematic)
+{
+    if (!ec_rigidbody || ec_rigidbody->handle == RIGIDBODY_HANDLE_NONE)
+        return;
+    WaitForStep(_manager);
+    RigidBodyStore *store = _manager->bodies;
+    uint32_t i = RigidBodyStore_Index(store, ec_rigidbody->handle);
+    if (!isKinematic)
+    {
+        store->flags[i] &= ~RIGIDBODY_KINEMATIC;
         return;
+    }
+    // Whatever rested on the body now has to follow the transform instead
+    WakeIsland(store, i);
+    store->flags[i] |= RIGIDBODY_KINEMATIC;
+    store->velocities[i] = V3_ZERO;
+    store->angularVelocities[i] = V3_ZERO;
+    store->forces[i] = V3_ZERO;
+    store->torques[i] = V3_ZERO;
+}
+
+V3 PhysicsManager_GetVelocity(EC_RigidBody *ec_rigidbody)
+{
+    if (!ec_rigidbody || ec_rigidbody->handle == RIGIDBODY_HANDLE_NONE)
+        return V3_ZERO;
+    WaitForStep(_manager);
+    return _manager->bodies->velocities[RigidBodyStore_Index(_manager->bodies, ec_rigidbody->handle)];
+}
 
-    ec_rigidbody->angularVelocity = angularVelocity;
+V3 PhysicsManager_GetAngularVelocity(EC_RigidBody *ec_rigidbody)
+{
+    if (!ec_rigidbody || ec_rigidbody->handle == RIGIDBODY_HANDLE_NONE)
+        return V3_ZERO;
+    WaitForStep(_manager);
+    return _manager->bodies->angularVelocities[RigidBodyStore_Index(_manager->bodies, ec_rigidbody->handle)];
 }
 
 // -------------------------
@@ -647,7 +1149,10 @@ void PhysicsManager_SetAngularVelocity(EC_RigidBody *ec_rigidbody, V3 angularVel
 void PhysicsManager_SetGravity(V3 gravity)
 {
     if (_manager)
+    {
+        WaitForStep(_manager);
         _manager->gravity = gravity;
+    }
 }
 
 V3 PhysicsManager_GetGravity()
@@ -660,7 +1165,10 @@ V3 PhysicsManager_GetGravity()
 void PhysicsManager_SetTimeStep(float timeStep)
 {
     if (_manager)
+    {
+        WaitForStep(_manager);
         _manager->timeStep = timeStep;
+    }
 }
 
 float PhysicsManager_GetTimeStep()
@@ -729,7 +1237,9 @@ static bool RayIntersectsTriangle(V3 rayOrigin, V3 rayDir,
 }
 
 /**
- * @brief Test ray against mesh collider with BVH optimization
+ * @brief Test ray against mesh collider with BVH optimization.
+ * @note Meshes stay in local space, the ray is brought into it instead: local = S^-1 * (R^T * (p - worldPos) - offset).
+ * The local direction is left unnormalized so hit distances stay in world units.
  */
 static bool RaycastMesh(V3 origin, V3 direction, EC_Collider *collider,
                         float maxDistance, RaycastHit *outHit)
@@ -744,157 +1254,220 @@ static bool RaycastMesh(V3 origin, V3 direction, EC_Collider *collider,
     V3 up = T_Up(transform);
     V3 forward = T_Forward(transform);
 
-    // Check if we have a BVH for fast raycast
-    MeshBVH *bvh = collider->data.mesh.bvh;
-    if (bvh)
-    {
-        // Use BVH for fast raycast
-        // Update BVH with current transform (for dynamic objects)
-        // TODO: Only update if transform changed significantly
-        MeshBVH_UpdateTransform(bvh, mesh, worldPos, worldScale, right, up, forward, collider->offset);
-
-        BVHRaycastHit bvhHit;
-        if (MeshBVH_Raycast(bvh, origin, direction, maxDistance, &bvhHit))
-        {
-            outHit->hit = true;
-            outHit->collider = collider;
-            outHit->distance = bvhHit.distance;
-            outHit->point = bvhHit.point;
-            outHit->normal = bvhHit.normal;
-            return true;
-        }
+    // A flattened mesh has no surface to hit
+    if (worldScale.x == 0.0f || worldScale.y == 0.0f || worldScale.z == 0.0f)
         return false;
-    }
-
-    // Fallback to brute force raycast for meshes without BVH
-    LogWarning(&_logConfig, "Performing brute force raycast on mesh without BVH - consider building BVH for better performance");
+    V3 invScale = {1.0f / worldScale.x, 1.0f / worldScale.y, 1.0f / worldScale.z};
+
+    // World to local
+    V3 relative = V3_SUB(origin, worldPos);
+    V3 localOrigin = {
+        V3_DOT(relative, right) - collider->offset.x,
+        V3_DOT(relative, up) - collider->offset.y,
+        V3_DOT(relative, forward) - collider->offset.z};
+    localOrigin = V3_MUL(localOrigin, invScale);
+    V3 localDirection = {
+        V3_DOT(direction, right),
+        V3_DOT(direction, up),
+        V3_DOT(direction, forward)};
+    localDirection = V3_MUL(localDirection, invScale);
 
     float closestDistance = maxDistance;
     bool hit = false;
-    V3 hitNormal = V3_ZERO;
+    V3 localNormal = V3_ZERO;
 
-    // Test against each triangle (original brute force method)
-    if (mesh->indices && mesh->indices_size > 0)
+    // Check if we have a BVH for fast raycast
+    MeshBVH *bvh = collider->data.mesh.bvh;
+    if (bvh)
     {
-        for (size_t i = 0; i < mesh->indices_size; i += 3)
+        BVHRaycastHit bvhHit;
+        if (MeshBVH_Raycast(bvh, localOrigin, localDirection, maxDistance, &bvhHit))
         {
-            // Get triangle vertices in local space
-            uint32_t idx0 = mesh->indices[i];
-            uint32_t idx1 = mesh->indices[i + 1];
-            uint32_t idx2 = mesh->indices[i + 2];
-
-            // Get vertex positions
-            V3 v0_local = mesh->vertices[idx0].position;
-            V3 v1_local = mesh->vertices[idx1].position;
-            V3 v2_local = mesh->vertices[idx2].position;
-
-            // Transform vertices to world space
-            // Apply scale
-            v0_local = V3_MUL(v0_local, worldScale);
-            v1_local = V3_MUL(v1_local, worldScale);
-            v2_local = V3_MUL(v2_local, worldScale);
-
-            // Apply rotation (using transform basis vectors)
-            V3 v0_world = {
-                v0_local.x * right.x + v0_local.y * up.x + v0_local.z * forward.x + worldPos.x,
-                v0_local.x * right.y + v0_local.y * up.y + v0_local.z * forward.y + worldPos.y,
-                v0_local.x * right.z + v0_local.y * up.z + v0_local.z * forward.z + worldPos.z};
-            V3 v1_world = {
-                v1_local.x * right.x + v1_local.y * up.x + v1_local.z * forward.x + worldPos.x,
-                v1_local.x * right.y + v1_local.y * up.y + v1_local.z * forward.y + worldPos.y,
-                v1_local.x * right.z + v1_local.y * up.z + v1_local.z * forward.z + worldPos.z};
-            V3 v2_world = {
-                v2_local.x * right.x + v2_local.y * up.x + v2_local.z * forward.x + worldPos.x,
-                v2_local.x * right.y + v2_local.y * up.y + v2_local.z * forward.y + worldPos.y,
-                v2_local.x * right.z + v2_local.y * up.z + v2_local.z * forward.z + worldPos.z};
-
-            // Apply collider offset
-            V3 offsetWorld = {
-                collider->offset.x * right.x + collider->offset.y * up.x + collider->offset.z * forward.x,
-                collider->offset.x * right.y + collider->offset.y * up.y + collider->offset.z * forward.y,
-                collider->offset.x * right.z + collider->offset.y * up.z + collider->offset.z * forward.z};
-            v0_world = V3_ADD(v0_world, offsetWorld);
-            v1_world = V3_ADD(v1_world, offsetWorld);
-            v2_world = V3_ADD(v2_world, offsetWorld);
-
-            // Test ray against triangle
-            float distance;
-            V3 normal;
-            if (RayIntersectsTriangle(origin, direction, v0_world, v1_world, v2_world,
-                                      &distance, &normal))
-            {
-                if (distance < closestDistance)
-                {
-                    closestDistance = distance;
-                    hitNormal = normal;
-                    hit = true;
-                }
-            }
+            hit = true;
+            closestDistance = bvhHit.distance;
+            localNormal = bvhHit.normal;
         }
     }
-    else if (mesh->vertices && mesh->vertices_size > 0)
+    else
     {
-        // Non-indexed mesh - iterate vertices by 3
-        for (size_t i = 0; i < mesh->vertices_size; i += 3)
+        // Fallback to brute force raycast for meshes without BVH
+        LogWarning(&_logConfig, "Performing brute force raycast on mesh without BVH - consider building BVH for better performance");
+
+        bool indexed = mesh->indices && mesh->indices_size > 0;
+        size_t count = indexed ? mesh->indices_size : mesh->vertices_size;
+        for (size_t i = 0; i + 2 < count; i += 3)
         {
-            V3 v0_local = mesh->vertices[i].position;
-            V3 v1_local = mesh->vertices[i + 1].position;
-            V3 v2_local = mesh->vertices[i + 2].position;
-
-            // Apply scale
-            v0_local = V3_MUL(v0_local, worldScale);
-            v1_local = V3_MUL(v1_local, worldScale);
-            v2_local = V3_MUL(v2_local, worldScale);
-
-            // Apply rotation
-            V3 v0_world = {
-                v0_local.x * right.x + v0_local.y * up.x + v0_local.z * forward.x + worldPos.x,
-                v0_local.x * right.y + v0_local.y * up.y + v0_local.z * forward.y + worldPos.y,
-                v0_local.x * right.z + v0_local.y * up.z + v0_local.z * forward.z + worldPos.z};
-            V3 v1_world = {
-                v1_local.x * right.x + v1_local.y * up.x + v1_local.z * forward.x + worldPos.x,
-                v1_local.x * right.y + v1_local.y * up.y + v1_local.z * forward.y + worldPos.y,
-                v1_local.x * right.z + v1_local.y * up.z + v1_local.z * forward.z + worldPos.z};
-            V3 v2_world = {
-                v2_local.x * right.x + v2_local.y * up.x + v2_local.z * forward.x + worldPos.x,
-                v2_local.x * right.y + v2_local.y * up.y + v2_local.z * forward.y + worldPos.y,
-                v2_local.x * right.z + v2_local.y * up.z + v2_local.z * forward.z + worldPos.z};
-
-            // Apply collider offset
-            V3 offsetWorld = {
-                collider->offset.x * right.x + collider->offset.y * up.x + collider->offset.z * forward.x,
-                collider->offset.x * right.y + collider->offset.y * up.y + collider->offset.z * forward.y,
-                collider->offset.x * right.z + collider->offset.y * up.z + collider->offset.z * forward.z};
-            v0_world = V3_ADD(v0_world, offsetWorld);
-            v1_world = V3_ADD(v1_world, offsetWorld);
-            v2_world = V3_ADD(v2_world, offsetWorld);
+            V3 v0 = mesh->vertices[indexed ? mesh->indices[i] : i].position;
+            V3 v1 = mesh->vertices[indexed ? mesh->indices[i + 1] : i + 1].position;
+            V3 v2 = mesh->vertices[indexed ? mesh->indices[i + 2] : i + 2].position;
 
             float distance;
             V3 normal;
-            if (RayIntersectsTriangle(origin, direction, v0_world, v1_world, v2_world,
-                                      &distance, &normal))
+            if (RayIntersectsTriangle(localOrigin, localDirection, v0, v1, v2, &distance, &normal) &&
+                distance < closestDistance)
             {
-                if (distance < closestDistance)
-                {
-                    closestDistance = distance;
-                    hitNormal = normal;
-                    hit = true;
-                }
+                closestDistance = distance;
+                localNormal = normal;
+                hit = true;
             }
         }
     }
 
-    if (hit)
+    if (!hit)
+        return false;
+
+    // Normals transform by the inverse transpose of R * S, which is R * S^-1
+    V3 n = V3_MUL(localNormal, invScale);
+    V3 worldNormal = {
+        n.x * right.x + n.y * up.x + n.z * forward.x,
+        n.x * right.y + n.y * up.y + n.z * forward.y,
+        n.x * right.z + n.y * up.z + n.z * forward.z};
+
+    outHit->hit = true;
+    outHit->collider = collider;
+    outHit->distance = closestDistance;
+    outHit->point = V3_ADD(origin, V3_SCALE(direction, closestDistance));
+    outHit->normal = V3_NORM(worldNormal);
+    return true;
+}
+
+/**
+ * @brief Test ray against a heightfield collider, walking its grid instead of a triangle BVH.
+ * @note The local AABB includes the offset before scaling, so the ray is brought in as local = S^-1 * R^T * (p - worldPos) - offset.
+ */
+static bool RaycastHeightfield(V3 origin, V3 direction, EC_Collider *collider,
+                               float maxDistance, RaycastHit *outHit)
+{
+    Transform *transform = collider->transform;
+    V3 worldPos = T_WPos(transform);
+    V3 worldScale = T_WSca(transform);
+    V3 right = T_Right(transform);
+    V3 up = T_Up(transform);
+    V3 forward = T_Forward(transform);
+
+    if (worldScale.x == 0.0f || worldScale.y == 0.0f || worldScale.z == 0.0f)
+        return false;
+    V3 invScale = {1.0f / worldScale.x, 1.0f / worldScale.y, 1.0f / worldScale.z};
+
+    // World to local
+    V3 relative = V3_SUB(origin, worldPos);
+    V3 localOrigin = {V3_DOT(relative, right), V3_DOT(relative, up), V3_DOT(relative, forward)};
+    localOrigin = V3_SUB(V3_MUL(localOrigin, invScale), collider->offset);
+    V3 localDirection = {V3_DOT(direction, right), V3_DOT(direction, up), V3_DOT(direction, forward)};
+    localDirection = V3_MUL(localDirection, invScale);
+
+    float distance;
+    V3 localNormal;
+    if (!Heightfield_Raycast(collider->data.heightfield.heightfield, localOrigin, localDirection, maxDistance, &distance, &localNormal))
+        return false;
+
+    // Normals transform by the inverse transpose of R * S, which is R * S^-1
+    V3 n = V3_MUL(localNormal, invScale);
+    V3 worldNormal = {
+        n.x * right.x + n.y * up.x + n.z * forward.x,
+        n.x * right.y + n.y * up.y + n.z * forward.y,
+        n.x * right.z + n.y * up.z + n.z * forward.z};
+
+    outHit->hit = true;
+    outHit->collider = collider;
+    outHit->distance = distance;
+    outHit->point = V3_ADD(origin, V3_SCALE(direction, distance));
+    outHit->normal = V3_NORM(worldNormal);
+    return true;
+}
+
+/// @brief Per-ray state shared by single and batched raycasts
+typedef struct RaycastContext
+{
+    const V3 *origins;
+    const V3 *directions;
+    RaycastHit *hits;
+    /// @brief Scene tree item of each ray's closest hit, breaks ties between equally distant hits
+    uint32_t *hitItems;
+} RaycastContext;
+
+/// @brief Growable buffers reused by PhysicsManager_RaycastBatch
+static struct
+{
+    size_t capacity;
+    V3 *origins;
+    V3 *directions;
+    V3 *invDirections;
+    float *maxDistances;
+    uint32_t *hitItems;
+} _batchScratch;
+
+inline static V3 InverseDirection(V3 direction)
+{
+    return (V3){
+        (fabsf(direction.x) > 0.0001f) ? 1.0f / direction.x : INFINITY,
+        (fabsf(direction.y) > 0.0001f) ? 1.0f / direction.y : INFINITY,
+        (fabsf(direction.z) > 0.0001f) ? 1.0f / direction.z : INFINITY};
+}
+
+/**
+ * @brief Narrow test of a ray against a collider whose bounds it enters at tEnter.
+ * @note Equally distant hits go to the lowest item, so the result does not depend on the order leaves are visited in
+ */
+static float RaycastCollider(void *context, uint32_t ray, uint32_t item, EC_Collider *collider, float tEnter, float tExit, float maxDistance)
+{
+    RaycastContext *ctx = context;
+    V3 origin = ctx->origins[ray];
+    V3 direction = ctx->directions[ray];
+    RaycastHit *closestHit = &ctx->hits[ray];
+    bool winsTie = closestHit->hit && item < ctx->hitItems[ray];
+
+    if (collider->type == EC_COLLIDER_MESH || collider->type == EC_COLLIDER_HEIGHTFIELD)
     {
-        outHit->hit = true;
-        outHit->collider = collider;
-        outHit->distance = closestDistance;
-        outHit->point = V3_ADD(origin, V3_SCALE(direction, closestDistance));
-        outHit->normal = hitNormal;
-        return true;
+        // Use precise triangle raycast
+        RaycastHit tempHit = {0};
+        float limit = winsTie ? nextafterf(maxDistance, INFINITY) : maxDistance;
+        bool hit = collider->type == EC_COLLIDER_MESH
+                       ? RaycastMesh(origin, direction, collider, limit, &tempHit)
+                       : RaycastHeightfield(origin, direction, collider, limit, &tempHit);
+        if (!hit)
+            return maxDistance;
+        if (!(tempHit.distance < maxDistance || (winsTie && tempHit.distance == maxDistance)))
+            return maxDistance;
+        *closestHit = tempHit;
+        ctx->hitItems[ray] = item;
+        return tempHit.distance;
     }
 
-    return false;
+    // For box/sphere/capsule, AABB test is sufficient (or add precise tests)
+    float hitDistance = (tEnter > 0.0f) ? tEnter : tExit;
+    if (!(hitDistance < maxDistance || (winsTie && hitDistance == maxDistance)))
+        return maxDistance;
+
+    AABB aabb = collider->worldAABB;
+    closestHit->hit = true;
+    closestHit->collider = collider;
+    closestHit->distance = hitDistance;
+    closestHit->point = V3_ADD(origin, V3_SCALE(direction, hitDistance));
+    ctx->hitItems[ray] = item;
+
+    // Calculate normal based on which face was hit
+    V3 center = V3_SCALE(V3_ADD(aabb.min, aabb.max), 0.5f);
+    V3 localHit = V3_SUB(closestHit->point, center);
+    V3 size = V3_SCALE(V3_SUB(aabb.max, aabb.min), 0.5f);
+
+    // Determine which axis has the largest normalized component
+    V3 normalized = {
+        localHit.x / size.x,
+        localHit.y / size.y,
+        localHit.z / size.z};
+
+    float absX = fabsf(normalized.x);
+    float absY = fabsf(normalized.y);
+    float absZ = fabsf(normalized.z);
+
+    if (absX > absY && absX > absZ)
+        closestHit->normal = (V3){(normalized.x > 0) ? 1.0f : -1.0f, 0, 0};
+    else if (absY > absZ)
+        closestHit->normal = (V3){0, (normalized.y > 0) ? 1.0f : -1.0f, 0};
+    else
+        closestHit->normal = (V3){0, 0, (normalized.z > 0) ? 1.0f : -1.0f};
+    return hitDistance;
 }
 
 bool PhysicsManager_Raycast(Ray *ray, float maxDistance, RaycastHit *outHit, uint32_t layerMask)
@@ -902,105 +1475,68 @@ bool PhysicsManager_Raycast(Ray *ray, float maxDistance, RaycastHit *outHit, uin
     if (!_manager || !outHit)
         return false;
 
-    V3 direction = V3_NORM(ray->direction);
     V3 origin = ray->origin;
-
+    V3 direction = V3_NORM(ray->direction);
     RaycastHit closestHit = {0};
     closestHit.distance = maxDistance;
     closestHit.hit = false;
+    uint32_t hitItem = SCENE_BVH_NONE;
 
-    // Check all colliders
-    for (int i = 0; i < _manager->rigidbodies_size; i++)
-    {
-        if (!_manager->rigidbodies[i])
-            continue;
-        // Check if the collider is raycastable
-        if (!(COLLISION_MASK[_manager->rigidbodies[i]->component->entity->layer] & (1 << E_LAYER_RAYCAST)))
-            continue;
-        // Check if the collider belongs to the specified layer mask
-        if (!(COLLISION_MASK[_manager->rigidbodies[i]->component->entity->layer] & layerMask))
-            continue;
-
-        EC_Collider *collider = _manager->rigidbodies[i]->ec_collider;
-        if (!collider)
-            continue;
+    RaycastContext context = {
+        .origins = &origin,
+        .directions = &direction,
+        .hits = &closestHit,
+        .hitItems = &hitItem};
 
-        // Quick AABB rejection test
-        AABB aabb = collider->worldAABB;
+    // Front-to-back traversal, non-raycastable layers and the layer mask are pruned per node
+    SceneBVH_Raycast(_manager->raycastTree, origin, InverseDirection(direction), maxDistance, layerMask, RaycastCollider, &context);
 
-        // Calculate intersection using slab method
-        V3 invDir = {
-            (fabsf(direction.x) > 0.0001f) ? 1.0f / direction.x : INFINITY,
-            (fabsf(direction.y) > 0.0001f) ? 1.0f / direction.y : INFINITY,
-            (fabsf(direction.z) > 0.0001f) ? 1.0f / direction.z : INFINITY};
-
-        float t1 = (aabb.min.x - origin.x) * invDir.x;
-        float t2 = (aabb.max.x - origin.x) * invDir.x;
-        float t3 = (aabb.min.y - origin.y) * invDir.y;
-        float t4 = (aabb.max.y - origin.y) * invDir.y;
-        float t5 = (aabb.min.z - origin.z) * invDir.z;
-        float t6 = (aabb.max.z - origin.z) * invDir.z;
+    *outHit = closestHit;
+    return closestHit.hit;
+}
 
-        float tmin = fmaxf(fmaxf(fminf(t1, t2), fminf(t3, t4)), fminf(t5, t6));
-        float tmax = fminf(fminf(fmaxf(t1, t2), fmaxf(t3, t4)), fmaxf(t5, t6));
+size_t PhysicsManager_RaycastBatch(const Ray *rays, size_t n, float maxDistance, RaycastHit *outHits, uint32_t layerMask)
+{
+    if (!_manager || !rays || !outHits || n == 0)
+        return 0;
 
-        // Skip if ray doesn't intersect AABB
-        if (tmax < tmin || tmax < 0.0f || tmin > closestHit.distance)
-            continue;
+    if (_batchScratch.capacity < n)
+    {
+        _batchScratch.capacity = n;
+        _batchScratch.origins = realloc(_batchScratch.origins, sizeof(V3) * n);
+        _batchScratch.directions = realloc(_batchScratch.directions, sizeof(V3) * n);
+        _batchScratch.invDirections = realloc(_batchScratch.invDirections, sizeof(V3) * n);
+        _batchScratch.maxDistances = realloc(_batchScratch.maxDistances, sizeof(float) * n);
+        _batchScratch.hitItems = realloc(_batchScratch.hitItems, sizeof(uint32_t) * n);
+    }
 
-        // Collision test based on collider type
-        RaycastHit tempHit = {0};
+    for (size_t i = 0; i < n; i++)
+    {
+        _batchScratch.origins[i] = rays[i].origin;
+        _batchScratch.directions[i] = V3_NORM(rays[i].direction);
+        _batchScratch.invDirections[i] = InverseDirection(_batchScratch.directions[i]);
+        _batchScratch.maxDistances[i] = maxDistance;
+        _batchScratch.hitItems[i] = SCENE_BVH_NONE;
+        outHits[i] = (RaycastHit){0};
+        outHits[i].distance = maxDistance;
+        outHits[i].hit = false;
+    }
 
-        if (collider->type == EC_COLLIDER_MESH)
-        {
-            // Use precise mesh raycast
-            if (RaycastMesh(origin, direction, collider, closestHit.distance, &tempHit))
-            {
-                if (tempHit.distance < closestHit.distance)
-                {
-                    closestHit = tempHit;
-                }
-            }
-        }
-        else
-        {
-            // For box/sphere/capsule, AABB test is sufficient (or add precise tests)
-            float hitDistance = (tmin > 0.0f) ? tmin : tmax;
+    RaycastContext context = {
+        .origins = _batchScratch.origins,
+        .directions = _batchScratch.directions,
+        .hits = outHits,
+        .hitItems = _batchScratch.hitItems};
+    SceneBVH_RaycastBatch(_manager->raycastTree, _batchScratch.origins, _batchScratch.invDirections, _batchScratch.maxDistances, n,
+                          layerMask, RaycastCollider, &context);
 
-            if (hitDistance < closestHit.distance)
-            {
-                closestHit.hit = true;
-                closestHit.collider = collider;
-                closestHit.distance = hitDistance;
-                closestHit.point = V3_ADD(origin, V3_SCALE(direction, hitDistance));
-
-                // Calculate normal based on which face was hit
-                V3 center = V3_SCALE(V3_ADD(aabb.min, aabb.max), 0.5f);
-                V3 localHit = V3_SUB(closestHit.point, center);
-                V3 size = V3_SCALE(V3_SUB(aabb.max, aabb.min), 0.5f);
-
-                // Determine which axis has the largest normalized component
-                V3 normalized = {
-                    localHit.x / size.x,
-                    localHit.y / size.y,
-                    localHit.z / size.z};
-
-                float absX = fabsf(normalized.x);
-                float absY = fabsf(normalized.y);
-                float absZ = fabsf(normalized.z);
-
-                if (absX > absY && absX > absZ)
-                    closestHit.normal = (V3){(normalized.x > 0) ? 1.0f : -1.0f, 0, 0};
-                else if (absY > absZ)
-                    closestHit.normal = (V3){0, (normalized.y > 0) ? 1.0f : -1.0f, 0};
-                else
-                    closestHit.normal = (V3){0, 0, (normalized.z > 0) ? 1.0f : -1.0f};
-            }
-        }
+    size_t hits = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (outHits[i].hit)
+            hits++;
     }
-
-    *outHit = closestHit;
-    return closestHit.hit;
+    return hits;
 }
 
 void RaycastHit_Init(RaycastHit *hit)
@@ -1012,69 +1548,79 @@ void RaycastHit_Init(RaycastHit *hit)
     hit->distance = 0.0f;
 }
 
-int PhysicsManager_BoxCast(V3 center, V3 halfExtents, EC_Collider **outColliders, int maxColliders)
+typedef struct OverlapContext
 {
-    if (!_manager || !outColliders)
-        return 0;
-
-    AABB boxAABB = {
-        .min = V3_SUB(center, halfExtents),
-        .max = V3_ADD(center, halfExtents)};
-
-    int count = 0;
-    for (int i = 0; i < _manager->rigidbodies_size && count < maxColliders; i++)
+    AABB box;
+    V3 center;
+    float radiusSq;
+    EC_Collider **outColliders;
+    int maxColliders;
+    int count;
+} OverlapContext;
+
+static bool CollectBoxOverlap(void *context, EC_Collider *collider, AABB bounds)
+{
+    OverlapContext *ctx = context;
+    if (AABB_Overlap(ctx->box, bounds))
     {
-        if (!_manager->rigidbodies[i])
-            continue;
-
-        EC_Collider *collider = _manager->rigidbodies[i]->ec_collider;
-        if (!collider)
-            continue;
-
-        if (AABB_Overlap(boxAABB, collider->worldAABB))
-        {
-            outColliders[count++] = collider;
-        }
+        ctx->outColliders[ctx->count++] = collider;
     }
-
-    return count;
+    return ctx->count < ctx->maxColliders;
 }
 
-int PhysicsManager_SphereCast(V3 center, float radius, EC_Collider **outColliders, int maxColliders)
+static bool CollectSphereOverlap(void *context, EC_Collider *collider, AABB bounds)
 {
-    if (!_manager || !outColliders)
-        return 0;
-
-    float radiusSq = radius * radius;
-    int count = 0;
-
-    for (int i = 0; i < _manager->rigidbodies_size && count < maxColliders; i++)
+    OverlapContext *ctx = context;
+    V3 center = ctx->center;
+
+    // Find closest point on AABB to sphere center
+    V3 closest = {
+        fmaxf(bounds.min.x, fminf(center.x, bounds.max.x)),
+        fmaxf(bounds.min.y, fminf(center.y, bounds.max.y)),
+        fmaxf(bounds.min.z, fminf(center.z, bounds.max.z))};
+
+    // Check if closest point is within sphere
+    V3 diff = V3_SUB(closest, center);
+    if (V3_DOT(diff, diff) <= ctx->radiusSq)
     {
-        if (!_manager->rigidbodies[i])
-            continue;
-
-        EC_Collider *collider = _manager->rigidbodies[i]->ec_collider;
-        if (!collider)
-            continue;
+        ctx->outColliders[ctx->count++] = collider;
+    }
+    return ctx->count < ctx->maxColliders;
+}
 
-        // Find closest point on AABB to sphere center
-        AABB aabb = collider->worldAABB;
-        V3 closest = {
-            fmaxf(aabb.min.x, fminf(center.x, aabb.max.x)),
-            fmaxf(aabb.min.y, fminf(center.y, aabb.max.y)),
-            fmaxf(aabb.min.z, fminf(center.z, aabb.max.z))};
+int PhysicsManager_BoxCast(V3 center, V3 halfExtents, EC_Collider **outColliders, int maxColliders, uint32_t layerMask)
+{
+    if (!_manager || !outColliders || maxColliders <= 0)
+        return 0;
 
-        // Check if closest point is within sphere
-        V3 diff = V3_SUB(closest, center);
-        float distSq = V3_DOT(diff, diff);
+    OverlapContext context = {
+        .box = {
+            .min = V3_SUB(center, halfExtents),
+            .max = V3_ADD(center, halfExtents)},
+        .outColliders = outColliders,
+        .maxColliders = maxColliders,
+        .count = 0};
+    SpatialHash_Query(_manager->overlapGrid, context.box, layerMask, CollectBoxOverlap, &context);
+    return context.count;
+}
 
-        if (distSq <= radiusSq)
-        {
-            outColliders[count++] = collider;
-        }
-    }
+int PhysicsManager_SphereCast(V3 center, float radius, EC_Collider **outColliders, int maxColliders, uint32_t layerMask)
+{
+    if (!_manager || !outColliders || maxColliders <= 0)
+        return 0;
 
-    return count;
+    V3 extents = {radius, radius, radius};
+    OverlapContext context = {
+        .box = {
+            .min = V3_SUB(center, extents),
+            .max = V3_ADD(center, extents)},
+        .center = center,
+        .radiusSq = radius * radius,
+        .outColliders = outColliders,
+        .maxColliders = maxColliders,
+        .count = 0};
+    SpatialHash_Query(_manager->overlapGrid, context.box, layerMask, CollectSphereOverlap, &context);
+    return context.count;
 }
 
 // -------------------------
@@ -1085,123 +1631,121 @@ int PhysicsManager_SphereCast(V3 center, float radius, EC_Collider **outCollider
 // Improved Velocity Integration with Better Sleeping
 // -------------------------
 
-static void IntegrateVelocity(EC_RigidBody *rigidbody, float deltaTime)
+static void IntegrateVelocity(RigidBodyStore *store, size_t i, float deltaTime)
 {
-    if (!rigidbody || rigidbody->isKinematic || *rigidbody->isStatic)
+    uint8_t flags = store->flags[i];
+    if (flags & (RIGIDBODY_KINEMATIC | RIGIDBODY_STATIC | RIGIDBODY_SLEEPING))
         return;
 
-    if (rigidbody->isSleeping)
-        return;
+    V3 velocity = store->velocities[i];
+    V3 angularVelocity = store->angularVelocities[i];
 
     // Apply gravity
-    if (rigidbody->useGravity)
+    if (flags & RIGIDBODY_GRAVITY)
     {
-        rigidbody->velocity = V3_ADD(rigidbody->velocity, V3_SCALE(_manager->gravity, deltaTime));
+        velocity = V3_ADD(velocity, V3_SCALE(_manager->gravity, deltaTime));
     }
 
     // Apply accumulated forces
-    if (rigidbody->mass > 0.0f)
+    if (store->invMasses[i] > 0.0f)
     {
-        V3 acceleration = V3_SCALE(rigidbody->forceAccum, 1.0f / rigidbody->mass);
-        rigidbody->velocity = V3_ADD(rigidbody->velocity, V3_SCALE(acceleration, deltaTime));
+        V3 acceleration = V3_SCALE(store->forces[i], store->invMasses[i]);
+        velocity = V3_ADD(velocity, V3_SCALE(acceleration, deltaTime));
     }
 
     // Apply linear damping
-    if (rigidbody->linearDamping > 0.0f)
+    if (store->linearDampings[i] > 0.0f)
     {
-        float damping = expf(-rigidbody->linearDamping * deltaTime);
-        rigidbody->velocity = V3_SCALE(rigidbody->velocity, damping);
+        float damping = expf(-store->linearDampings[i] * deltaTime);
+        velocity = V3_SCALE(velocity, damping);
     }
 
     // Integrate angular forces (torque)
-    rigidbody->angularVelocity = V3_ADD(rigidbody->angularVelocity,
-                                        V3_SCALE(rigidbody->torqueAccum, deltaTime));
+    angularVelocity = V3_ADD(angularVelocity, V3_SCALE(store->torques[i], deltaTime));
 
     // Apply angular damping
-    if (rigidbody->angularDamping > 0.0f)
+    if (store->angularDampings[i] > 0.0f)
     {
-        float damping = expf(-rigidbody->angularDamping * deltaTime);
-        rigidbody->angularVelocity = V3_SCALE(rigidbody->angularVelocity, damping);
+        float damping = expf(-store->angularDampings[i] * deltaTime);
+        angularVelocity = V3_SCALE(angularVelocity, damping);
     }
 
     // Calculate magnitudes for sleeping check
-    float velocityMag = V3_MAGNITUDE(rigidbody->velocity);
-    float angularMag = V3_MAGNITUDE(rigidbody->angularVelocity);
+    float velocityMag = V3_MAGNITUDE(velocity);
+    float angularMag = V3_MAGNITUDE(angularVelocity);
 
     // Enhanced sleeping logic
     if (velocityMag < SLEEP_VELOCITY_THRESHOLD && angularMag < SLEEP_ANGULAR_THRESHOLD)
     {
-        rigidbody->sleepTimer += deltaTime;
+        store->sleepTimers[i] += deltaTime;
 
         // Apply aggressive damping near sleep threshold
-        if (rigidbody->sleepTimer > SLEEP_TIME_THRESHOLD * 0.5f)
-        {
-            rigidbody->velocity = V3_SCALE(rigidbody->velocity, RESTING_VELOCITY_DAMPING);
-            rigidbody->angularVelocity = V3_SCALE(rigidbody->angularVelocity, RESTING_VELOCITY_DAMPING);
-        }
-
-        if (rigidbody->sleepTimer >= SLEEP_TIME_THRESHOLD)
+        if (store->sleepTimers[i] > SLEEP_TIME_THRESHOLD * 0.5f)
         {
-            rigidbody->isSleeping = true;
-            rigidbody->velocity = V3_ZERO;
-            rigidbody->angularVelocity = V3_ZERO;
+            velocity = V3_SCALE(velocity, RESTING_VELOCITY_DAMPING);
+            angularVelocity = V3_SCALE(angularVelocity, RESTING_VELOCITY_DAMPING);
         }
+        // SleepIslands puts the body to sleep once its whole island rested long enough
     }
     else if (velocityMag > WAKE_VELOCITY_THRESHOLD || angularMag > WAKE_VELOCITY_THRESHOLD)
     {
-        rigidbody->sleepTimer = 0.0f;
+        store->sleepTimers[i] = 0.0f;
     }
 
+    store->velocities[i] = velocity;
+    store->angularVelocities[i] = angularVelocity;
+
     // Clear accumulators
-    rigidbody->forceAccum = V3_ZERO;
-    rigidbody->torqueAccum = V3_ZERO;
+    store->forces[i] = V3_ZERO;
+    store->torques[i] = V3_ZERO;
 }
 
 // -------------------------
 // Position Integration WITH ROTATION
 // -------------------------
 
-static void IntegratePosition(EC_RigidBody *rigidbody, float deltaTime)
+static void IntegratePosition(RigidBodyStore *store, size_t i, float deltaTime)
 {
-    if (!rigidbody || rigidbody->isKinematic || *rigidbody->isStatic)
+    uint8_t flags = store->flags[i];
+    if (flags & (RIGIDBODY_KINEMATIC | RIGIDBODY_STATIC | RIGIDBODY_SLEEPING))
         return;
 
-    if (rigidbody->isSleeping)
-        return;
+    const RigidBodyConstraints *constraints = &store->constraints[i];
+    V3 velocity = store->velocities[i];
+    V3 angularVelocity = store->angularVelocities[i];
 
     // Apply position constraints
-    if (rigidbody->constraints.freezePositionX)
-        rigidbody->velocity.x = 0.0f;
-    if (rigidbody->constraints.freezePositionY)
-        rigidbody->velocity.y = 0.0f;
-    if (rigidbody->constraints.freezePositionZ)
-        rigidbody->velocity.z = 0.0f;
+    if (constraints->freezePositionX)
+        velocity.x = 0.0f;
+    if (constraints->freezePositionY)
+        velocity.y = 0.0f;
+    if (constraints->freezePositionZ)
+        velocity.z = 0.0f;
 
     // Apply rotation constraints
-    if (rigidbody->constraints.freezeRotationX)
-        rigidbody->angularVelocity.x = 0.0f;
-    if (rigidbody->constraints.freezeRotationY)
-        rigidbody->angularVelocity.y = 0.0f;
-    if (rigidbody->constraints.freezeRotationZ)
-        rigidbody->angularVelocity.z = 0.0f;
+    if (constraints->freezeRotationX)
+        angularVelocity.x = 0.0f;
+    if (constraints->freezeRotationY)
+        angularVelocity.y = 0.0f;
+    if (constraints->freezeRotationZ)
+        angularVelocity.z = 0.0f;
 
-    Transform *transform = &rigidbody->component->entity->transform;
+    store->velocities[i] = velocity;
+    store->angularVelocities[i] = angularVelocity;
 
     // Integrate linear position
-    V3 deltaPos = V3_SCALE(rigidbody->velocity, deltaTime);
-    T_LPos_Add(transform, deltaPos);
+    V3 deltaPos = V3_SCALE(velocity, deltaTime);
+    store->positions[i] = V3_ADD(store->positions[i], deltaPos);
+    flags |= RIGIDBODY_MOVED;
 
     // ===== INTEGRATE ROTATION =====
     // Using semi-implicit Euler integration for quaternions
-    float angularSpeed = V3_MAGNITUDE(rigidbody->angularVelocity);
+    float angularSpeed = V3_MAGNITUDE(angularVelocity);
 
     if (angularSpeed > 0.0001f)
     {
-        // Get current rotation
-        Quaternion currentRot = T_LRot(transform); // Get local rotation quaternion
-
         // Normalize angular velocity to get axis
-        V3 axis = V3_SCALE(rigidbody->angularVelocity, 1.0f / angularSpeed);
+        V3 axis = V3_SCALE(angularVelocity, 1.0f / angularSpeed);
 
         // Calculate rotation angle for this timestep
         float angle = angularSpeed * deltaTime;
@@ -1216,47 +1760,262 @@ static void IntegratePosition(EC_RigidBody *rigidbody, float deltaTime)
         deltaRot.z = axis.z * sinHalfAngle;
         deltaRot.w = cosf(halfAngle);
 
-        // Apply rotation: newRot = deltaRot * currentRot
-        Quaternion newRot = Quat_Mul(deltaRot, currentRot);
+        // Apply rotation: newRot = deltaRot * currentRot, normalized to prevent drift
+        store->rotations[i] = Quat_Norm(Quat_Mul(deltaRot, store->rotations[i]));
+        flags |= RIGIDBODY_ROTATED;
+    }
+    store->flags[i] = flags;
+}
 
-        // Normalize to prevent drift
-        newRot = Quat_Norm(newRot);
+// -------------------------
+// State Sync
+// -------------------------
 
-        // Set the new rotation
-        T_LRot_Set(transform, newRot);
+/// @brief Read what game code may have changed since the last step: local pose, layer, static flag and world bounds
+static void PullStateRange(void *data, size_t begin, size_t end)
+{
+    RigidBodyStore *store = data;
+    for (size_t i = begin; i < end; i++)
+    {
+        if (store->flags[i] & RIGIDBODY_SLEEPING)
+        {
+            // PullState woke the island if anything moved it, nothing else can change
+            store->flags[i] &= ~(RIGIDBODY_MOVED | RIGIDBODY_ROTATED);
+            continue;
+        }
+        EC_RigidBody *ec_rigidbody = store->bodies[i];
+        Entity *entity = ec_rigidbody->component->entity;
+        store->positions[i] = T_LPos(&entity->transform);
+        store->rotations[i] = T_LRot(&entity->transform);
+        store->layers[i] = entity->layer;
+        uint8_t flags = store->flags[i] & ~(RIGIDBODY_STATIC | RIGIDBODY_MOVED | RIGIDBODY_ROTATED);
+        store->flags[i] = *ec_rigidbody->isStatic ? flags | RIGIDBODY_STATIC : flags;
+        if (HasMovingProxy(ec_rigidbody))
+        {
+            UpdateWorldAABB(ec_rigidbody->ec_collider);
+        }
+        if (ec_rigidbody->ec_collider)
+        {
+            store->worldAABBs[i] = ec_rigidbody->ec_collider->worldAABB;
+        }
+    }
+}
 
-        // Update world rotation cache if you're using it
-        rigidbody->w_rot = newRot;
+static void PullState(TaskPool *pool, RigidBodyStore *store)
+{
+    // A sleeping body that gameplay code moved wakes its island
+    for (size_t i = 0; i < store->size; i++)
+    {
+        if (!(store->flags[i] & RIGIDBODY_SLEEPING))
+            continue;
+        Transform *transform = &store->bodies[i]->component->entity->transform;
+        if (!SamePose(T_LPos(transform), T_LRot(transform), store->positions[i], store->rotations[i]))
+        {
+            WakeIsland(store, (uint32_t)i);
+        }
+    }
+    // Cleaning a transform writes its whole subtree. Clean every parent first, so a body only cleans its own
+    // subtree below, and that subtree holds no other body (it would have cleaned it here otherwise).
+    for (size_t i = 0; i < store->size; i++)
+    {
+        EC_RigidBody *ec_rigidbody = store->bodies[i];
+        if (!(store->flags[i] & RIGIDBODY_SLEEPING) && HasMovingProxy(ec_rigidbody) && ec_rigidbody->ec_collider->transform &&
+            ec_rigidbody->ec_collider->transform->parent)
+        {
+            T_Clean(ec_rigidbody->ec_collider->transform->parent);
+        }
+    }
+    TaskPool_ParallelFor(pool, store->size, PHYSICS_PARALLEL_CHUNK, PullStateRange, store);
+}
+
+/// @brief Write the poses that changed this step back to the transforms. Setters mark whole subtrees dirty, so this stays serial.
+static void PushState(RigidBodyStore *store)
+{
+    for (size_t i = 0; i < store->size; i++)
+    {
+        uint8_t flags = store->flags[i];
+        if (!(flags & (RIGIDBODY_MOVED | RIGIDBODY_ROTATED)))
+            continue;
+        Transform *transform = &store->bodies[i]->component->entity->transform;
+        if (flags & RIGIDBODY_MOVED)
+            T_LPos_Set(transform, store->positions[i]);
+        if (flags & RIGIDBODY_ROTATED)
+            T_LRot_Set(transform, store->rotations[i]);
     }
 }
 
 // -------------------------
-// Functions
+// Parallel Stages
 // -------------------------
 
-void PhysicsManager_FixedUpdate(PhysicsManager *physicsManager)
+static void IntegrateVelocityRange(void *data, size_t begin, size_t end)
 {
-    // Step 1: Integrate velocities
-    for (int i = 0; i < physicsManager->rigidbodies_size; i++)
+    PhysicsManager *physicsManager = data;
+    for (size_t i = begin; i < end; i++)
     {
-        if (physicsManager->rigidbodies[i])
-        {
-            IntegrateVelocity(physicsManager->rigidbodies[i], physicsManager->timeStep);
-        }
+        IntegrateVelocity(physicsManager->bodies, i, physicsManager->timeStep);
     }
+}
 
-    // Step 2: Collision detection
+static void IntegratePositionRange(void *data, size_t begin, size_t end)
+{
+    PhysicsManager *physicsManager = data;
+    for (size_t i = begin; i < end; i++)
+    {
+        IntegratePosition(physicsManager->bodies, i, physicsManager->timeStep);
+    }
+}
+
+// -------------------------
+// Physics Thread Loop
+// -------------------------
+
+/// @brief The stages that only touch the store, the broadphase and the contact cache, run on the physics thread
+static void SolveStep(PhysicsManager *physicsManager)
+{
+    // Bodies are integrated independently, so spreading them over the pool gives the serial result bit for bit
+    TaskPool *pool = TaskPool_Get();
+    RigidBodyStore *store = physicsManager->bodies;
+    ResetIslands(store->size);
+
+    // Integrate velocities
+    TaskPool_ParallelFor(pool, store->size, PHYSICS_PARALLEL_CHUNK, IntegrateVelocityRange, physicsManager);
+
+    // Collision detection
     BroadPhase();
     NarrowPhase();
 
-    // Step 3: Integrate positions
-    for (int i = 0; i < _manager->rigidbodies_size; i++)
+    // Put resting islands to sleep, then integrate positions
+    SleepIslands(store);
+    TaskPool_ParallelFor(pool, store->size, PHYSICS_PARALLEL_CHUNK, IntegratePositionRange, physicsManager);
+}
+
+static void *PhysicsThreadLoop(void *data)
+{
+    PhysicsManager *physicsManager = data;
+    pthread_mutex_lock(&physicsManager->mutex);
+    while (true)
     {
-        if (_manager->rigidbodies[i])
-        {
-            IntegratePosition(_manager->rigidbodies[i], _manager->timeStep);
-        }
+        while (!physicsManager->stepPending && !physicsManager->stopping)
+            pthread_cond_wait(&physicsManager->stepQueued, &physicsManager->mutex);
+        if (!physicsManager->stepPending)
+            break;
+        pthread_mutex_unlock(&physicsManager->mutex);
+        SolveStep(physicsManager);
+        pthread_mutex_lock(&physicsManager->mutex);
+        physicsManager->stepPending = false;
+        pthread_cond_broadcast(&physicsManager->stepDone);
+    }
+    pthread_mutex_unlock(&physicsManager->mutex);
+    return NULL;
+}
+
+// -------------------------
+// Functions
+// -------------------------
+
+void PhysicsManager_BeginStep(PhysicsManager *physicsManager)
+{
+    PhysicsManager_EndStep(physicsManager);
+    PhysicsManager_EndInterpolation(physicsManager);
+    RigidBodyStore *store = physicsManager->bodies;
+
+    // Step 1: Apply gameplay writes and read the transforms, the solver works on the store only
+    ApplyCommands(store);
+    PullState(TaskPool_Get(), store);
+    UpdateQueryProxies(store);
+
+    // Step 2: Solve on the physics thread
+    physicsManager->stepInFlight = true;
+    if (!physicsManager->threaded)
+    {
+        SolveStep(physicsManager);
+        return;
+    }
+    pthread_mutex_lock(&physicsManager->mutex);
+    physicsManager->stepPending = true;
+    pthread_cond_signal(&physicsManager->stepQueued);
+    pthread_mutex_unlock(&physicsManager->mutex);
+}
+
+void PhysicsManager_EndStep(PhysicsManager *physicsManager)
+{
+    if (!physicsManager->stepInFlight)
+        return;
+    WaitForStep(physicsManager);
+    physicsManager->stepInFlight = false;
+    PhysicsManager_EndInterpolation(physicsManager);
+
+    // Step 3: Write the new poses to the transforms and keep them for interpolation
+    PushState(physicsManager->bodies);
+    PublishSnapshot(physicsManager);
+    DetectTriggerOverlaps(physicsManager);
+
+    // Step 4: Let gameplay code react, now that the step can no longer be disturbed
+    DispatchCollisionEvents();
+}
+
+void PhysicsManager_FixedUpdate(PhysicsManager *physicsManager)
+{
+    PhysicsManager_BeginStep(physicsManager);
+    PhysicsManager_EndStep(physicsManager);
+}
+
+// -------------------------
+// Interpolation
+// -------------------------
+
+void PhysicsManager_Interpolate(PhysicsManager *physicsManager, float alpha)
+{
+    PhysicsManager_EndInterpolation(physicsManager);
+    const PhysicsSnapshot *previous = &physicsManager->snapshots[physicsManager->currentSnapshot ^ 1];
+    const PhysicsSnapshot *current = &physicsManager->snapshots[physicsManager->currentSnapshot];
+    // Bodies were added or removed since the older snapshot, draw them where they are
+    if (previous->size != current->size || current->size == 0)
+        return;
+    alpha = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha);
+    PhysicsSnapshot *saved = &physicsManager->savedPoses;
+    ReserveSnapshot(saved, current->size);
+    saved->size = current->size;
+    for (size_t i = 0; i < current->size; i++)
+    {
+        saved->bodies[i] = NULL;
+        if (SamePose(previous->positions[i], previous->rotations[i], current->positions[i], current->rotations[i]))
+            continue;
+        Transform *transform = &current->bodies[i]->component->entity->transform;
+        saved->bodies[i] = current->bodies[i];
+        saved->positions[i] = T_LPos(transform);
+        saved->rotations[i] = T_LRot(transform);
+        T_LPos_Set(transform, LerpPosition(previous->positions[i], current->positions[i], alpha));
+        T_LRot_Set(transform, LerpRotation(previous->rotations[i], current->rotations[i], alpha));
+    }
+    physicsManager->interpolationAlpha = alpha;
+    physicsManager->interpolated = true;
+}
+
+void PhysicsManager_EndInterpolation(PhysicsManager *physicsManager)
+{
+    if (!physicsManager->interpolated)
+        return;
+    physicsManager->interpolated = false;
+    const PhysicsSnapshot *previous = &physicsManager->snapshots[physicsManager->currentSnapshot ^ 1];
+    const PhysicsSnapshot *current = &physicsManager->snapshots[physicsManager->currentSnapshot];
+    const PhysicsSnapshot *saved = &physicsManager->savedPoses;
+    float alpha = physicsManager->interpolationAlpha;
+    for (size_t i = 0; i < saved->size; i++)
+    {
+        if (!saved->bodies[i])
+            continue;
+        Transform *transform = &saved->bodies[i]->component->entity->transform;
+        // Gameplay code moved the transform after it was interpolated, its write wins
+        V3 position = LerpPosition(previous->positions[i], current->positions[i], alpha);
+        Quaternion rotation = LerpRotation(previous->rotations[i], current->rotations[i], alpha);
+        if (!SamePose(T_LPos(transform), T_LRot(transform), position, rotation))
+            continue;
+        T_LPos_Set(transform, saved->positions[i]);
+        T_LRot_Set(transform, saved->rotations[i]);
     }
+    physicsManager->savedPoses.size = 0;
 }
 
 // -------------------------
@@ -1265,6 +2024,9 @@ void PhysicsManager_FixedUpdate(PhysicsManager *physicsManager)
 
 void PhysicsManager_Select(PhysicsManager *physicsManager)
 {
+    // The physics thread solves against the selected manager, let it finish first
+    if (_manager && _manager != physicsManager)
+        WaitForStep(_manager);
     _manager = physicsManager;
     LogSuccess(&_logConfig, "Selected Physics Manager.");
 }
@@ -1276,13 +2038,31 @@ void PhysicsManager_Select(PhysicsManager *physicsManager)
 PhysicsManager *PhysicsManager_Create(float timeStep)
 {
     PhysicsManager *manager = malloc(sizeof(PhysicsManager));
-    manager->rigidbodies_size = 0;
-    manager->rigidbodies = NULL;
+    memset(manager, 0, sizeof(PhysicsManager));
+    manager->bodies = RigidBodyStore_Create();
+    manager->contacts = ContactCache_Create();
+    manager->triggerContacts = ContactCache_Create();
+    manager->events_size = 0;
+    manager->events_capacity = 0;
+    manager->events = NULL;
+    manager->broadphase = SweepAndPrune_Create();
+    manager->raycastTree = SceneBVH_Create();
+    manager->overlapGrid = SpatialHash_Create(PHYSICS_OVERLAP_CELL_SIZE, PHYSICS_OVERLAP_BUCKETS);
 
     // Initialize physics settings
     manager->gravity = (V3){0.0f, PHYSICS_GRAVITY_EARTH, 0.0f};
     manager->timeStep = timeStep;
 
+    // Physics thread
+    pthread_mutex_init(&manager->mutex, NULL);
+    pthread_cond_init(&manager->stepQueued, NULL);
+    pthread_cond_init(&manager->stepDone, NULL);
+    manager->threaded = pthread_create(&manager->thread, NULL, PhysicsThreadLoop, manager) == 0;
+    if (!manager->threaded)
+    {
+        LogWarning(&_logConfig, "Failed to start the physics thread, steps will be solved inline.");
+    }
+
     LogCreate(&_logConfig, "");
     PhysicsManager_Select(manager);
     return manager;
@@ -1291,8 +2071,56 @@ PhysicsManager *PhysicsManager_Create(float timeStep)
 void PhysicsManager_Free(PhysicsManager *manager)
 {
     PhysicsManager_Select(manager);
+    PhysicsManager_EndStep(manager);
+    PhysicsManager_EndInterpolation(manager);
+    // Physics thread
+    if (manager->threaded)
+    {
+        pthread_mutex_lock(&manager->mutex);
+        manager->stopping = true;
+        pthread_cond_signal(&manager->stepQueued);
+        pthread_mutex_unlock(&manager->mutex);
+        pthread_join(manager->thread, NULL);
+    }
+    pthread_cond_destroy(&manager->stepQueued);
+    pthread_cond_destroy(&manager->stepDone);
+    pthread_mutex_destroy(&manager->mutex);
     // Rigidbodies
-    free(manager->rigidbodies);
+    RigidBodyStore_Free(manager->bodies);
+    ContactCache_Free(manager->contacts);
+    ContactCache_Free(manager->triggerContacts);
+    free(manager->triggers);
+    free(manager->events);
+    free(manager->commands);
+    // Snapshots
+    FreeSnapshot(&manager->snapshots[0]);
+    FreeSnapshot(&manager->snapshots[1]);
+    FreeSnapshot(&manager->savedPoses);
+    // Island scratch
+    free(_islandScratch.parents);
+    free(_islandScratch.minSleepTimers);
+    free(_islandScratch.islandIds);
+    _islandScratch.capacity = 0;
+    _islandScratch.parents = NULL;
+    _islandScratch.minSleepTimers = NULL;
+    _islandScratch.islandIds = NULL;
+    SweepAndPrune_Free(manager->broadphase);
+    SceneBVH_Free(manager->raycastTree);
+    SpatialHash_Free(manager->overlapGrid);
+    // Raycast batch scratch
+    free(_batchScratch.origins);
+    free(_batchScratch.directions);
+    free(_batchScratch.invDirections);
+    free(_batchScratch.maxDistances);
+    free(_batchScratch.hitItems);
+    _batchScratch.capacity = 0;
+    _batchScratch.origins = NULL;
+    _batchScratch.directions = NULL;
+    _batchScratch.invDirections = NULL;
+    _batchScratch.maxDistances = NULL;
+    _batchScratch.hitItems = NULL;
+    if (_manager == manager)
+        _manager = NULL;
     free(manager);
     LogFree(&_logConfig, "");
 }
\ No newline at end of file
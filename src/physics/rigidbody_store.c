@@ -0,0 +1,165 @@
+#include "physics/rigidbody_store.h"
+// C
+#include <stdlib.h>
+#include <string.h>
+// Logging
+#include "logging/logger.h"
+
+// -------------------------
+// Static Variables
+// -------------------------
+
+static LogConfig _logConfig = {"RigidBodyStore", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
+
+// -------------------------
+// Helpers
+// -------------------------
+
+static void Grow(RigidBodyStore *store)
+{
+    store->capacity = store->capacity == 0 ? 16 : store->capacity * 2;
+    size_t n = store->capacity;
+    store->bodies = realloc(store->bodies, sizeof(EC_RigidBody *) * n);
+    store->handles = realloc(store->handles, sizeof(uint32_t) * n);
+    store->positions = realloc(store->positions, sizeof(V3) * n);
+    store->rotations = realloc(store->rotations, sizeof(Quaternion) * n);
+    store->velocities = realloc(store->velocities, sizeof(V3) * n);
+    store->angularVelocities = realloc(store->angularVelocities, sizeof(V3) * n);
+    store->forces = realloc(store->forces, sizeof(V3) * n);
+    store->torques = realloc(store->torques, sizeof(V3) * n);
+    store->invMasses = realloc(store->invMasses, sizeof(float) * n);
+    store->linearDampings = realloc(store->linearDampings, sizeof(float) * n);
+    store->angularDampings = realloc(store->angularDampings, sizeof(float) * n);
+    store->sleepTimers = realloc(store->sleepTimers, sizeof(float) * n);
+    store->sleepIslands = realloc(store->sleepIslands, sizeof(uint32_t) * n);
+    store->constraints = realloc(store->constraints, sizeof(RigidBodyConstraints) * n);
+    store->flags = realloc(store->flags, sizeof(uint8_t) * n);
+    store->worldAABBs = realloc(store->worldAABBs, sizeof(AABB) * n);
+    store->layers = realloc(store->layers, sizeof(uint8_t) * n);
+}
+
+/// @brief Copy every field of body src into index dst
+static void MoveBody(RigidBodyStore *store, size_t dst, size_t src)
+{
+    store->bodies[dst] = store->bodies[src];
+    store->handles[dst] = store->handles[src];
+    store->positions[dst] = store->positions[src];
+    store->rotations[dst] = store->rotations[src];
+    store->velocities[dst] = store->velocities[src];
+    store->angularVelocities[dst] = store->angularVelocities[src];
+    store->forces[dst] = store->forces[src];
+    store->torques[dst] = store->torques[src];
+    store->invMasses[dst] = store->invMasses[src];
+    store->linearDampings[dst] = store->linearDampings[src];
+    store->angularDampings[dst] = store->angularDampings[src];
+    store->sleepTimers[dst] = store->sleepTimers[src];
+    store->sleepIslands[dst] = store->sleepIslands[src];
+    store->constraints[dst] = store->constraints[src];
+    store->flags[dst] = store->flags[src];
+    store->worldAABBs[dst] = store->worldAABBs[src];
+    store->layers[dst] = store->layers[src];
+}
+
+// -------------------------
+// Bodies
+// -------------------------
+
+uint32_t RigidBodyStore_Add(RigidBodyStore *store, EC_RigidBody *body)
+{
+    uint32_t handle;
+    if (store->freeHandles_size > 0)
+    {
+        handle = store->freeHandles[--store->freeHandles_size];
+    }
+    else
+    {
+        if (store->slots_size >= store->slots_capacity)
+        {
+            store->slots_capacity = store->slots_capacity == 0 ? 16 : store->slots_capacity * 2;
+            store->slots = realloc(store->slots, sizeof(uint32_t) * store->slots_capacity);
+            store->freeHandles = realloc(store->freeHandles, sizeof(uint32_t) * store->slots_capacity);
+        }
+        handle = (uint32_t)store->slots_size++;
+    }
+    if (store->size >= store->capacity)
+    {
+        Grow(store);
+    }
+    size_t index = store->size++;
+    store->slots[handle] = (uint32_t)index;
+    store->bodies[index] = body;
+    store->handles[index] = handle;
+    store->positions[index] = V3_ZERO;
+    store->rotations[index] = QUATERNION_IDENTITY;
+    store->velocities[index] = V3_ZERO;
+    store->angularVelocities[index] = V3_ZERO;
+    store->forces[index] = V3_ZERO;
+    store->torques[index] = V3_ZERO;
+    store->invMasses[index] = 0.0f;
+    store->linearDampings[index] = 0.0f;
+    store->angularDampings[index] = 0.0f;
+    store->sleepTimers[index] = 0.0f;
+    store->sleepIslands[index] = 0;
+    memset(&store->constraints[index], 0, sizeof(RigidBodyConstraints));
+    store->flags[index] = 0;
+    store->worldAABBs[index] = (AABB){0};
+    store->layers[index] = 0;
+    return handle;
+}
+
+void RigidBodyStore_Remove(RigidBodyStore *store, uint32_t handle)
+{
+    if (handle >= store->slots_size || store->slots[handle] == RIGIDBODY_HANDLE_NONE)
+    {
+        LogWarning(&_logConfig, "Failed to remove body %u, not found.", handle);
+        return;
+    }
+    size_t index = store->slots[handle];
+    size_t last = --store->size;
+    if (index != last)
+    {
+        MoveBody(store, index, last);
+        store->slots[store->handles[index]] = (uint32_t)index;
+    }
+    store->slots[handle] = RIGIDBODY_HANDLE_NONE;
+    store->freeHandles[store->freeHandles_size++] = handle;
+}
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+RigidBodyStore *RigidBodyStore_Create()
+{
+    RigidBodyStore *store = malloc(sizeof(RigidBodyStore));
+    memset(store, 0, sizeof(RigidBodyStore));
+    LogCreate(&_logConfig, "");
+    return store;
+}
+
+void RigidBodyStore_Free(RigidBodyStore *store)
+{
+    if (!store)
+        return;
+    free(store->bodies);
+    free(store->handles);
+    free(store->positions);
+    free(store->rotations);
+    free(store->velocities);
+    free(store->angularVelocities);
+    free(store->forces);
+    free(store->torques);
+    free(store->invMasses);
+    free(store->linearDampings);
+    free(store->angularDampings);
+    free(store->sleepTimers);
+    free(store->sleepIslands);
+    free(store->constraints);
+    free(store->flags);
+    free(store->worldAABBs);
+    free(store->layers);
+    free(store->slots);
+    free(store->freeHandles);
+    free(store);
+    LogFree(&_logConfig, "");
+}
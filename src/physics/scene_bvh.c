@@ -0,0 +1,450 @@
+#include "physics/scene_bvh.h"
+// C
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+// Logging
+#include "logging/logger.h"
+
+// -------------------------
+// Static Variables
+// -------------------------
+
+static LogConfig _logConfig = {"SceneBVH", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
+
+#define SCENE_BVH_STACK_SIZE 64
+/// @brief Below this depth nodes are split evenly, which bounds the depth of the tree by the stack size
+#define SCENE_BVH_BALANCED_DEPTH 40
+#define SCENE_BVH_PACKET_SIZE 32
+
+// -------------------------
+// Helpers
+// -------------------------
+
+inline static float Axis(V3 v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+inline static float SurfaceArea(V3 min, V3 max)
+{
+    V3 d = V3_SUB(max, min);
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+/// @brief Slab test, matches the test PhysicsManager_Raycast used on every collider before the tree existed
+inline static bool RayIntersectsBounds(V3 origin, V3 invDir, V3 min, V3 max, float maxDistance, float *outEnter, float *outExit)
+{
+    float t1 = (min.x - origin.x) * invDir.x;
+    float t2 = (max.x - origin.x) * invDir.x;
+    float t3 = (min.y - origin.y) * invDir.y;
+    float t4 = (max.y - origin.y) * invDir.y;
+    float t5 = (min.z - origin.z) * invDir.z;
+    float t6 = (max.z - origin.z) * invDir.z;
+
+    float tmin = fmaxf(fmaxf(fminf(t1, t2), fminf(t3, t4)), fminf(t5, t6));
+    float tmax = fminf(fminf(fmaxf(t1, t2), fmaxf(t3, t4)), fmaxf(t5, t6));
+
+    if (tmax < tmin || tmax < 0.0f || tmin > maxDistance)
+        return false;
+    *outEnter = tmin;
+    *outExit = tmax;
+    return true;
+}
+
+static float TreeCost(SceneBVH *bvh)
+{
+    if (bvh->nodes_size == 0)
+        return 0.0f;
+    float rootArea = SurfaceArea(bvh->nodes[0].min, bvh->nodes[0].max);
+    if (rootArea <= 0.0f)
+        return 0.0f;
+    float cost = 0.0f;
+    for (size_t i = 0; i < bvh->nodes_size; i++)
+    {
+        if (bvh->nodes[i].item == SCENE_BVH_NONE)
+            cost += SurfaceArea(bvh->nodes[i].min, bvh->nodes[i].max);
+    }
+    return cost / rootArea;
+}
+
+// -------------------------
+// Building
+// -------------------------
+
+static uint32_t BuildNode(SceneBVH *bvh, uint32_t *items, size_t count, int depth)
+{
+    uint32_t index = (uint32_t)bvh->nodes_size++;
+    SceneBVHNode *node = &bvh->nodes[index];
+
+    if (count == 1)
+    {
+        SceneBVHItem *item = &bvh->items[items[0]];
+        node->min = item->min;
+        node->max = item->max;
+        node->layerMask = item->layerMask;
+        node->left = SCENE_BVH_NONE;
+        node->right = SCENE_BVH_NONE;
+        node->item = items[0];
+        return index;
+    }
+
+    // Split at the middle of the longest axis of the centroids' bounds
+    V3 cMin = V3_SCALE(V3_ADD(bvh->items[items[0]].min, bvh->items[items[0]].max), 0.5f);
+    V3 cMax = cMin;
+    for (size_t i = 1; i < count; i++)
+    {
+        V3 c = V3_SCALE(V3_ADD(bvh->items[items[i]].min, bvh->items[items[i]].max), 0.5f);
+        cMin = V3_MIN(cMin, c);
+        cMax = V3_MAX(cMax, c);
+    }
+    V3 extent = V3_SUB(cMax, cMin);
+    int axis = 0;
+    if (extent.y > extent.x)
+        axis = 1;
+    if (extent.z > Axis(extent, axis))
+        axis = 2;
+    float split = 0.5f * (Axis(cMin, axis) + Axis(cMax, axis));
+
+    size_t mid = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        SceneBVHItem *item = &bvh->items[items[i]];
+        if (0.5f * (Axis(item->min, axis) + Axis(item->max, axis)) < split)
+        {
+            uint32_t tmp = items[i];
+            items[i] = items[mid];
+            items[mid++] = tmp;
+        }
+    }
+    // All centroids on one side (e.g. stacked boxes) - fall back to an even split
+    if (mid == 0 || mid == count || depth >= SCENE_BVH_BALANCED_DEPTH)
+        mid = count / 2;
+
+    uint32_t left = BuildNode(bvh, items, mid, depth + 1);
+    uint32_t right = BuildNode(bvh, items + mid, count - mid, depth + 1);
+    // Children may have grown the array, re-fetch the node
+    node = &bvh->nodes[index];
+    node->left = left;
+    node->right = right;
+    node->item = SCENE_BVH_NONE;
+    node->min = V3_MIN(bvh->nodes[left].min, bvh->nodes[right].min);
+    node->max = V3_MAX(bvh->nodes[left].max, bvh->nodes[right].max);
+    node->layerMask = bvh->nodes[left].layerMask | bvh->nodes[right].layerMask;
+    return index;
+}
+
+static void Rebuild(SceneBVH *bvh)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < bvh->items_size; i++)
+    {
+        if (bvh->items[i].inUse)
+            bvh->buildItems[count++] = (uint32_t)i;
+    }
+
+    bvh->nodes_size = 0;
+    if (count > 0)
+    {
+        if (bvh->nodes_capacity < 2 * count - 1)
+        {
+            bvh->nodes_capacity = 2 * count - 1;
+            bvh->nodes = realloc(bvh->nodes, sizeof(SceneBVHNode) * bvh->nodes_capacity);
+        }
+        BuildNode(bvh, bvh->buildItems, count, 0);
+    }
+    bvh->buildCost = TreeCost(bvh);
+    bvh->needsRebuild = false;
+}
+
+static void Refit(SceneBVH *bvh)
+{
+    // Depth-first order puts children after their parent, walk backwards to refit bottom-up
+    for (size_t i = bvh->nodes_size; i-- > 0;)
+    {
+        SceneBVHNode *node = &bvh->nodes[i];
+        if (node->item != SCENE_BVH_NONE)
+        {
+            SceneBVHItem *item = &bvh->items[node->item];
+            node->min = item->min;
+            node->max = item->max;
+            node->layerMask = item->layerMask;
+            continue;
+        }
+        SceneBVHNode *left = &bvh->nodes[node->left];
+        SceneBVHNode *right = &bvh->nodes[node->right];
+        node->min = V3_MIN(left->min, right->min);
+        node->max = V3_MAX(left->max, right->max);
+        node->layerMask = left->layerMask | right->layerMask;
+    }
+}
+
+// -------------------------
+// Items
+// -------------------------
+
+uint32_t SceneBVH_Insert(SceneBVH *bvh, EC_Collider *collider, AABB bounds, uint32_t layerMask)
+{
+    uint32_t item;
+    if (bvh->freeItems_size > 0)
+    {
+        item = bvh->freeItems[--bvh->freeItems_size];
+    }
+    else
+    {
+        if (bvh->items_size >= bvh->items_capacity)
+        {
+            bvh->items_capacity = bvh->items_capacity == 0 ? 16 : bvh->items_capacity * 2;
+            bvh->items = realloc(bvh->items, sizeof(SceneBVHItem) * bvh->items_capacity);
+            bvh->freeItems = realloc(bvh->freeItems, sizeof(uint32_t) * bvh->items_capacity);
+            bvh->buildItems = realloc(bvh->buildItems, sizeof(uint32_t) * bvh->items_capacity);
+        }
+        item = (uint32_t)bvh->items_size++;
+    }
+    bvh->items[item] = (SceneBVHItem){
+        .collider = collider,
+        .min = bounds.min,
+        .max = bounds.max,
+        .layerMask = layerMask,
+        .inUse = true};
+    bvh->needsRebuild = true;
+    return item;
+}
+
+void SceneBVH_Remove(SceneBVH *bvh, uint32_t item)
+{
+    if (item >= bvh->items_size || !bvh->items[item].inUse)
+    {
+        LogWarning(&_logConfig, "Failed to remove item %u, not found.", item);
+        return;
+    }
+    bvh->items[item].inUse = false;
+    bvh->items[item].collider = NULL;
+    bvh->freeItems[bvh->freeItems_size++] = item;
+    bvh->needsRebuild = true;
+}
+
+void SceneBVH_UpdateItem(SceneBVH *bvh, uint32_t item, AABB bounds, uint32_t layerMask)
+{
+    SceneBVHItem *it = &bvh->items[item];
+    it->min = bounds.min;
+    it->max = bounds.max;
+    it->layerMask = layerMask;
+}
+
+// -------------------------
+// Update & Queries
+// -------------------------
+
+void SceneBVH_Update(SceneBVH *bvh)
+{
+    if (bvh->needsRebuild)
+    {
+        Rebuild(bvh);
+        return;
+    }
+    Refit(bvh);
+    if (TreeCost(bvh) > bvh->buildCost * SCENE_BVH_REBUILD_COST_FACTOR)
+    {
+        Rebuild(bvh);
+    }
+}
+
+float SceneBVH_Raycast(SceneBVH *bvh, V3 origin, V3 invDirection, float maxDistance, uint32_t layerMask,
+                       SceneBVHRaycastCallback callback, void *context)
+{
+    // Items added or removed since the last update are not in the tree yet
+    if (bvh->needsRebuild)
+        Rebuild(bvh);
+    if (bvh->nodes_size == 0)
+        return maxDistance;
+
+    float tEnter, tExit;
+    if (!(bvh->nodes[0].layerMask & layerMask) ||
+        !RayIntersectsBounds(origin, invDirection, bvh->nodes[0].min, bvh->nodes[0].max, maxDistance, &tEnter, &tExit))
+        return maxDistance;
+
+    uint32_t stack[SCENE_BVH_STACK_SIZE];
+    float stackEnter[SCENE_BVH_STACK_SIZE];
+    float stackExit[SCENE_BVH_STACK_SIZE];
+    int stack_size = 0;
+    stack[stack_size] = 0;
+    stackEnter[stack_size] = tEnter;
+    stackExit[stack_size++] = tExit;
+
+    while (stack_size > 0)
+    {
+        stack_size--;
+        // A closer hit may have been found since this node was pushed
+        if (stackEnter[stack_size] > maxDistance)
+            continue;
+        SceneBVHNode *node = &bvh->nodes[stack[stack_size]];
+
+        if (node->item != SCENE_BVH_NONE)
+        {
+            maxDistance = callback(context, 0, node->item, bvh->items[node->item].collider,
+                                   stackEnter[stack_size], stackExit[stack_size], maxDistance);
+            continue;
+        }
+
+        uint32_t children[2] = {node->left, node->right};
+        float enter[2], exit[2];
+        bool hit[2];
+        for (int c = 0; c < 2; c++)
+        {
+            SceneBVHNode *child = &bvh->nodes[children[c]];
+            hit[c] = (child->layerMask & layerMask) &&
+                     RayIntersectsBounds(origin, invDirection, child->min, child->max, maxDistance, &enter[c], &exit[c]);
+        }
+        // Push the farther child first so the nearer one is visited next
+        int first = (hit[0] && hit[1] && enter[1] < enter[0]) ? 1 : 0;
+        int order[2] = {1 - first, first};
+        for (int c = 0; c < 2; c++)
+        {
+            int child = order[c];
+            if (!hit[child])
+                continue;
+            if (stack_size >= SCENE_BVH_STACK_SIZE)
+            {
+                LogWarning(&_logConfig, "Raycast stack overflow, tree is too deep.");
+                continue;
+            }
+            stack[stack_size] = children[child];
+            stackEnter[stack_size] = enter[child];
+            stackExit[stack_size++] = exit[child];
+        }
+    }
+    return maxDistance;
+}
+
+/// @brief Traverse the tree once for a packet of rays sharing a direction octant
+static void RaycastPacket(SceneBVH *bvh, const uint32_t *packet, uint32_t packet_size, V3 octant,
+                          const V3 *origins, const V3 *invDirections, float *maxDistances, uint32_t layerMask,
+                          SceneBVHRaycastCallback callback, void *context)
+{
+    uint32_t stack[SCENE_BVH_STACK_SIZE];
+    uint32_t stackMask[SCENE_BVH_STACK_SIZE];
+    int stack_size = 0;
+    stack[stack_size] = 0;
+    stackMask[stack_size++] = packet_size == 32 ? UINT32_MAX : ((1u << packet_size) - 1u);
+
+    float enter[SCENE_BVH_PACKET_SIZE], exit[SCENE_BVH_PACKET_SIZE];
+    while (stack_size > 0)
+    {
+        stack_size--;
+        SceneBVHNode *node = &bvh->nodes[stack[stack_size]];
+        if (!(node->layerMask & layerMask))
+            continue;
+
+        // Keep only the rays that still reach this node
+        uint32_t active = 0;
+        for (uint32_t mask = stackMask[stack_size]; mask; mask &= mask - 1)
+        {
+            uint32_t lane = (uint32_t)__builtin_ctz(mask);
+            uint32_t ray = packet[lane];
+            if (RayIntersectsBounds(origins[ray], invDirections[ray], node->min, node->max, maxDistances[ray], &enter[lane], &exit[lane]))
+                active |= 1u << lane;
+        }
+        if (!active)
+            continue;
+
+        if (node->item != SCENE_BVH_NONE)
+        {
+            for (uint32_t mask = active; mask; mask &= mask - 1)
+            {
+                uint32_t lane = (uint32_t)__builtin_ctz(mask);
+                uint32_t ray = packet[lane];
+                maxDistances[ray] = callback(context, ray, node->item, bvh->items[node->item].collider,
+                                             enter[lane], exit[lane], maxDistances[ray]);
+            }
+            continue;
+        }
+
+        if (stack_size + 2 > SCENE_BVH_STACK_SIZE)
+        {
+            LogWarning(&_logConfig, "Raycast stack overflow, tree is too deep.");
+            continue;
+        }
+        // Every ray of the packet travels the same way, so the child nearer along the octant goes first
+        SceneBVHNode *left = &bvh->nodes[node->left];
+        SceneBVHNode *right = &bvh->nodes[node->right];
+        V3 delta = V3_SUB(V3_ADD(right->min, right->max), V3_ADD(left->min, left->max));
+        bool leftFirst = V3_DOT(delta, octant) >= 0.0f;
+        stack[stack_size] = leftFirst ? node->right : node->left;
+        stackMask[stack_size++] = active;
+        stack[stack_size] = leftFirst ? node->left : node->right;
+        stackMask[stack_size++] = active;
+    }
+}
+
+void SceneBVH_RaycastBatch(SceneBVH *bvh, const V3 *origins, const V3 *invDirections, float *maxDistances, size_t rays_size,
+                           uint32_t layerMask, SceneBVHRaycastCallback callback, void *context)
+{
+    if (bvh->needsRebuild)
+        Rebuild(bvh);
+    if (bvh->nodes_size == 0 || rays_size == 0)
+        return;
+
+    if (bvh->rayOrder_capacity < rays_size)
+    {
+        bvh->rayOrder_capacity = rays_size;
+        bvh->rayOrder = realloc(bvh->rayOrder, sizeof(uint32_t) * rays_size);
+    }
+
+    // Counting sort of the rays by direction octant
+    size_t octantStart[9] = {0};
+    for (size_t i = 0; i < rays_size; i++)
+    {
+        V3 inv = invDirections[i];
+        int octant = (inv.x < 0.0f) | ((inv.y < 0.0f) << 1) | ((inv.z < 0.0f) << 2);
+        octantStart[octant + 1]++;
+    }
+    for (int o = 0; o < 8; o++)
+        octantStart[o + 1] += octantStart[o];
+    size_t octantFill[8];
+    memcpy(octantFill, octantStart, sizeof(octantFill));
+    for (size_t i = 0; i < rays_size; i++)
+    {
+        V3 inv = invDirections[i];
+        int octant = (inv.x < 0.0f) | ((inv.y < 0.0f) << 1) | ((inv.z < 0.0f) << 2);
+        bvh->rayOrder[octantFill[octant]++] = (uint32_t)i;
+    }
+
+    for (int o = 0; o < 8; o++)
+    {
+        V3 octant = {(o & 1) ? -1.0f : 1.0f, (o & 2) ? -1.0f : 1.0f, (o & 4) ? -1.0f : 1.0f};
+        for (size_t start = octantStart[o]; start < octantStart[o + 1]; start += SCENE_BVH_PACKET_SIZE)
+        {
+            size_t packet_size = octantStart[o + 1] - start;
+            if (packet_size > SCENE_BVH_PACKET_SIZE)
+                packet_size = SCENE_BVH_PACKET_SIZE;
+            RaycastPacket(bvh, &bvh->rayOrder[start], (uint32_t)packet_size, octant,
+                          origins, invDirections, maxDistances, layerMask, callback, context);
+        }
+    }
+}
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+SceneBVH *SceneBVH_Create()
+{
+    SceneBVH *bvh = malloc(sizeof(SceneBVH));
+    memset(bvh, 0, sizeof(SceneBVH));
+    LogCreate(&_logConfig, "");
+    return bvh;
+}
+
+void SceneBVH_Free(SceneBVH *bvh)
+{
+    if (!bvh)
+        return;
+    free(bvh->items);
+    free(bvh->freeItems);
+    free(bvh->buildItems);
+    free(bvh->rayOrder);
+    free(bvh->nodes);
+    free(bvh);
+    LogFree(&_logConfig, "");
+}
@@ -0,0 +1,281 @@
+#include "physics/spatial_hash.h"
+// C
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+// Logging
+#include "logging/logger.h"
+
+// -------------------------
+// Static Variables
+// -------------------------
+
+static LogConfig _logConfig = {"SpatialHash", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
+
+// -------------------------
+// Helpers
+// -------------------------
+
+inline static int32_t CellCoord(SpatialHash *hash, float value)
+{
+    return (int32_t)floorf(value * hash->invCellSize);
+}
+
+inline static SpatialHashBucket *GetBucket(SpatialHash *hash, int32_t x, int32_t y, int32_t z, uint32_t layer)
+{
+    uint32_t h = ((uint32_t)x * 73856093u) ^ ((uint32_t)y * 19349663u) ^ ((uint32_t)z * 83492791u) ^ (layer * 2654435761u);
+    return &hash->buckets[h & (hash->buckets_size - 1)];
+}
+
+static void CellRange(SpatialHash *hash, AABB bounds, int32_t outMin[3], int32_t outMax[3])
+{
+    outMin[0] = CellCoord(hash, bounds.min.x);
+    outMin[1] = CellCoord(hash, bounds.min.y);
+    outMin[2] = CellCoord(hash, bounds.min.z);
+    outMax[0] = CellCoord(hash, bounds.max.x);
+    outMax[1] = CellCoord(hash, bounds.max.y);
+    outMax[2] = CellCoord(hash, bounds.max.z);
+}
+
+inline static size_t CellCount(const int32_t min[3], const int32_t max[3])
+{
+    return (size_t)(max[0] - min[0] + 1) * (size_t)(max[1] - min[1] + 1) * (size_t)(max[2] - min[2] + 1);
+}
+
+static void AddEntry(SpatialHash *hash, int32_t x, int32_t y, int32_t z, uint32_t layer, uint32_t item)
+{
+    SpatialHashBucket *bucket = GetBucket(hash, x, y, z, layer);
+    if (bucket->entries_size >= bucket->entries_capacity)
+    {
+        bucket->entries_capacity = bucket->entries_capacity == 0 ? 4 : bucket->entries_capacity * 2;
+        bucket->entries = realloc(bucket->entries, sizeof(SpatialHashEntry) * bucket->entries_capacity);
+    }
+    bucket->entries[bucket->entries_size++] = (SpatialHashEntry){x, y, z, layer, item};
+}
+
+static void RemoveEntry(SpatialHash *hash, int32_t x, int32_t y, int32_t z, uint32_t layer, uint32_t item)
+{
+    SpatialHashBucket *bucket = GetBucket(hash, x, y, z, layer);
+    for (uint32_t i = 0; i < bucket->entries_size; i++)
+    {
+        SpatialHashEntry *entry = &bucket->entries[i];
+        if (entry->item == item && entry->x == x && entry->y == y && entry->z == z)
+        {
+            *entry = bucket->entries[--bucket->entries_size];
+            return;
+        }
+    }
+}
+
+static void Link(SpatialHash *hash, uint32_t index)
+{
+    SpatialHashItem *item = &hash->items[index];
+    CellRange(hash, item->bounds, item->cellMin, item->cellMax);
+    item->isLarge = CellCount(item->cellMin, item->cellMax) > SPATIAL_HASH_MAX_ITEM_CELLS;
+    if (item->isLarge)
+    {
+        if (hash->largeItems_size >= hash->largeItems_capacity)
+        {
+            hash->largeItems_capacity = hash->largeItems_capacity == 0 ? 4 : hash->largeItems_capacity * 2;
+            hash->largeItems = realloc(hash->largeItems, sizeof(uint32_t) * hash->largeItems_capacity);
+        }
+        hash->largeItems[hash->largeItems_size++] = index;
+        return;
+    }
+    for (int32_t x = item->cellMin[0]; x <= item->cellMax[0]; x++)
+        for (int32_t y = item->cellMin[1]; y <= item->cellMax[1]; y++)
+            for (int32_t z = item->cellMin[2]; z <= item->cellMax[2]; z++)
+                AddEntry(hash, x, y, z, item->layer, index);
+}
+
+static void Unlink(SpatialHash *hash, uint32_t index)
+{
+    SpatialHashItem *item = &hash->items[index];
+    if (item->isLarge)
+    {
+        for (size_t i = 0; i < hash->largeItems_size; i++)
+        {
+            if (hash->largeItems[i] == index)
+            {
+                hash->largeItems[i] = hash->largeItems[--hash->largeItems_size];
+                return;
+            }
+        }
+        return;
+    }
+    for (int32_t x = item->cellMin[0]; x <= item->cellMax[0]; x++)
+        for (int32_t y = item->cellMin[1]; y <= item->cellMax[1]; y++)
+            for (int32_t z = item->cellMin[2]; z <= item->cellMax[2]; z++)
+                RemoveEntry(hash, x, y, z, item->layer, index);
+}
+
+/// @brief Returns false if the item was already reported by the current query
+inline static bool Stamp(SpatialHash *hash, SpatialHashItem *item)
+{
+    if (item->queryStamp == hash->queryStamp)
+        return false;
+    item->queryStamp = hash->queryStamp;
+    return true;
+}
+
+// -------------------------
+// Items
+// -------------------------
+
+uint32_t SpatialHash_Insert(SpatialHash *hash, EC_Collider *collider, AABB bounds, uint32_t layer)
+{
+    uint32_t item;
+    if (hash->freeItems_size > 0)
+    {
+        item = hash->freeItems[--hash->freeItems_size];
+    }
+    else
+    {
+        if (hash->items_size >= hash->items_capacity)
+        {
+            hash->items_capacity = hash->items_capacity == 0 ? 16 : hash->items_capacity * 2;
+            hash->items = realloc(hash->items, sizeof(SpatialHashItem) * hash->items_capacity);
+            hash->freeItems = realloc(hash->freeItems, sizeof(uint32_t) * hash->items_capacity);
+        }
+        item = (uint32_t)hash->items_size++;
+    }
+    hash->items[item] = (SpatialHashItem){
+        .collider = collider,
+        .bounds = bounds,
+        .layer = layer,
+        .inUse = true,
+        .queryStamp = 0};
+    Link(hash, item);
+    return item;
+}
+
+void SpatialHash_Remove(SpatialHash *hash, uint32_t item)
+{
+    if (item >= hash->items_size || !hash->items[item].inUse)
+    {
+        LogWarning(&_logConfig, "Failed to remove item %u, not found.", item);
+        return;
+    }
+    Unlink(hash, item);
+    hash->items[item].inUse = false;
+    hash->items[item].collider = NULL;
+    hash->freeItems[hash->freeItems_size++] = item;
+}
+
+void SpatialHash_Update(SpatialHash *hash, uint32_t item, AABB bounds, uint32_t layer)
+{
+    SpatialHashItem *it = &hash->items[item];
+    it->bounds = bounds;
+
+    int32_t cellMin[3], cellMax[3];
+    CellRange(hash, bounds, cellMin, cellMax);
+    if (layer == it->layer &&
+        memcmp(cellMin, it->cellMin, sizeof(cellMin)) == 0 &&
+        memcmp(cellMax, it->cellMax, sizeof(cellMax)) == 0)
+        return;
+
+    // Moved to other cells - re-insert
+    Unlink(hash, item);
+    it->layer = layer;
+    Link(hash, item);
+}
+
+// -------------------------
+// Queries
+// -------------------------
+
+void SpatialHash_Query(SpatialHash *hash, AABB bounds, uint32_t layerMask, SpatialHashQueryCallback callback, void *context)
+{
+    if (++hash->queryStamp == 0)
+    {
+        // Stamp wrapped around, old stamps could collide with new queries
+        for (size_t i = 0; i < hash->items_size; i++)
+            hash->items[i].queryStamp = 0;
+        hash->queryStamp = 1;
+    }
+
+    for (size_t i = 0; i < hash->largeItems_size; i++)
+    {
+        SpatialHashItem *item = &hash->items[hash->largeItems[i]];
+        if (!(layerMask & (1u << item->layer)) || !Stamp(hash, item))
+            continue;
+        if (!callback(context, item->collider, item->bounds))
+            return;
+    }
+
+    int32_t cellMin[3], cellMax[3];
+    CellRange(hash, bounds, cellMin, cellMax);
+
+    uint32_t layers = 0;
+    for (uint32_t mask = layerMask; mask; mask &= mask - 1)
+        layers++;
+
+    // Visiting the cells would cost more than walking every item
+    if (CellCount(cellMin, cellMax) * layers > hash->items_size)
+    {
+        for (size_t i = 0; i < hash->items_size; i++)
+        {
+            SpatialHashItem *item = &hash->items[i];
+            if (!item->inUse || item->isLarge || !(layerMask & (1u << item->layer)) || !Stamp(hash, item))
+                continue;
+            if (!callback(context, item->collider, item->bounds))
+                return;
+        }
+        return;
+    }
+
+    for (uint32_t mask = layerMask; mask; mask &= mask - 1)
+    {
+        uint32_t layer = (uint32_t)__builtin_ctz(mask);
+        for (int32_t x = cellMin[0]; x <= cellMax[0]; x++)
+            for (int32_t y = cellMin[1]; y <= cellMax[1]; y++)
+                for (int32_t z = cellMin[2]; z <= cellMax[2]; z++)
+                {
+                    SpatialHashBucket *bucket = GetBucket(hash, x, y, z, layer);
+                    for (uint32_t e = 0; e < bucket->entries_size; e++)
+                    {
+                        SpatialHashEntry *entry = &bucket->entries[e];
+                        if (entry->x != x || entry->y != y || entry->z != z || entry->layer != layer)
+                            continue;
+                        SpatialHashItem *item = &hash->items[entry->item];
+                        if (!Stamp(hash, item))
+                            continue;
+                        if (!callback(context, item->collider, item->bounds))
+                            return;
+                    }
+                }
+    }
+}
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+SpatialHash *SpatialHash_Create(float cellSize, size_t bucketCount)
+{
+    SpatialHash *hash = malloc(sizeof(SpatialHash));
+    memset(hash, 0, sizeof(SpatialHash));
+    hash->cellSize = cellSize;
+    hash->invCellSize = 1.0f / cellSize;
+    size_t buckets_size = 1;
+    while (buckets_size < bucketCount)
+        buckets_size <<= 1;
+    hash->buckets_size = buckets_size;
+    hash->buckets = calloc(buckets_size, sizeof(SpatialHashBucket));
+    LogCreate(&_logConfig, "Cell size %.2f, %zu buckets", cellSize, buckets_size);
+    return hash;
+}
+
+void SpatialHash_Free(SpatialHash *hash)
+{
+    if (!hash)
+        return;
+    for (size_t i = 0; i < hash->buckets_size; i++)
+        free(hash->buckets[i].entries);
+    free(hash->buckets);
+    free(hash->items);
+    free(hash->freeItems);
+    free(hash->largeItems);
+    free(hash);
+    LogFree(&_logConfig, "");
+}
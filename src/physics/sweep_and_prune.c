@@ -0,0 +1,274 @@
+#include "physics/sweep_and_prune.h"
+// C
+#include <stdlib.h>
+#include <string.h>
+// Logging
+#include "logging/logger.h"
+
+// -------------------------
+// Static Variables
+// -------------------------
+
+static LogConfig _logConfig = {"SweepAndPrune", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
+
+// -------------------------
+// Helpers
+// -------------------------
+
+#define ENDPOINT_PROXY(data) ((data) >> 1)
+#define ENDPOINT_IS_MAX(data) ((data) & 1u)
+
+inline static float AABB_Axis(const V3 *v, int axis)
+{
+    return axis == 0 ? v->x : (axis == 1 ? v->y : v->z);
+}
+
+inline static float EndpointValue(const SAPProxy *proxy, uint32_t data, int axis)
+{
+    return ENDPOINT_IS_MAX(data) ? AABB_Axis(&proxy->aabb.max, axis) : AABB_Axis(&proxy->aabb.min, axis);
+}
+
+/// @brief Orders by value; on ties, min endpoints come first so touching boxes count as overlapping
+inline static bool EndpointLess(const SAPEndpoint *a, const SAPEndpoint *b)
+{
+    if (a->value != b->value)
+        return a->value < b->value;
+    return !ENDPOINT_IS_MAX(a->data) && ENDPOINT_IS_MAX(b->data);
+}
+
+static void InsertionSort(SAPEndpoint *endpoints, size_t count)
+{
+    for (size_t i = 1; i < count; i++)
+    {
+        SAPEndpoint key = endpoints[i];
+        size_t j = i;
+        while (j > 0 && EndpointLess(&key, &endpoints[j - 1]))
+        {
+            endpoints[j] = endpoints[j - 1];
+            j--;
+        }
+        endpoints[j] = key;
+    }
+}
+
+inline static bool Overlap1D(const SAPProxy *a, const SAPProxy *b, int axis)
+{
+    return AABB_Axis(&a->aabb.min, axis) <= AABB_Axis(&b->aabb.max, axis) &&
+           AABB_Axis(&a->aabb.max, axis) >= AABB_Axis(&b->aabb.min, axis);
+}
+
+inline static bool ShouldPair(const SAPProxy *a, const SAPProxy *b)
+{
+    if (!SweepAndPrune_MotionsPair(a->motion, b->motion))
+        return false;
+    return (a->collisionMask & b->layerBit) && (b->collisionMask & a->layerBit);
+}
+
+static void PushPair(SweepAndPrune *sap, uint32_t proxyA, uint32_t proxyB)
+{
+    if (sap->pairs_size >= sap->pairs_capacity)
+    {
+        sap->pairs_capacity = sap->pairs_capacity == 0 ? 64 : sap->pairs_capacity * 2;
+        sap->pairs = realloc(sap->pairs, sizeof(SAPPair) * sap->pairs_capacity);
+    }
+    sap->pairs[sap->pairs_size++] = (SAPPair){proxyA, proxyB};
+}
+
+// -------------------------
+// Proxies
+// -------------------------
+
+uint32_t SweepAndPrune_AddProxy(SweepAndPrune *sap, EC_RigidBody *rigidbody, AABB aabb, uint32_t layerBit, uint32_t collisionMask, SAPMotion motion)
+{
+    uint32_t proxy;
+    if (sap->freeProxies_size > 0)
+    {
+        proxy = sap->freeProxies[--sap->freeProxies_size];
+    }
+    else
+    {
+        if (sap->proxies_size >= sap->proxies_capacity)
+        {
+            sap->proxies_capacity = sap->proxies_capacity == 0 ? 16 : sap->proxies_capacity * 2;
+            sap->proxies = realloc(sap->proxies, sizeof(SAPProxy) * sap->proxies_capacity);
+            sap->freeProxies = realloc(sap->freeProxies, sizeof(uint32_t) * sap->proxies_capacity);
+            sap->active = realloc(sap->active, sizeof(uint32_t) * sap->proxies_capacity);
+            sap->activeSlot = realloc(sap->activeSlot, sizeof(uint32_t) * sap->proxies_capacity);
+        }
+        proxy = (uint32_t)sap->proxies_size++;
+    }
+    sap->proxies[proxy] = (SAPProxy){
+        .rigidbody = rigidbody,
+        .aabb = aabb,
+        .layerBit = layerBit,
+        .collisionMask = collisionMask,
+        .motion = motion,
+        .inUse = true};
+
+    // Append both endpoints to every axis, the next update sorts them into place
+    if (sap->endpoints_size + 2 > sap->endpoints_capacity)
+    {
+        sap->endpoints_capacity = sap->endpoints_capacity == 0 ? 32 : sap->endpoints_capacity * 2;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            sap->endpoints[axis] = realloc(sap->endpoints[axis], sizeof(SAPEndpoint) * sap->endpoints_capacity);
+        }
+    }
+    for (int axis = 0; axis < 3; axis++)
+    {
+        sap->endpoints[axis][sap->endpoints_size] = (SAPEndpoint){AABB_Axis(&aabb.min, axis), proxy << 1};
+        sap->endpoints[axis][sap->endpoints_size + 1] = (SAPEndpoint){AABB_Axis(&aabb.max, axis), (proxy << 1) | 1u};
+    }
+    sap->endpoints_size += 2;
+    return proxy;
+}
+
+void SweepAndPrune_RemoveProxy(SweepAndPrune *sap, uint32_t proxy)
+{
+    if (proxy >= sap->proxies_size || !sap->proxies[proxy].inUse)
+    {
+        LogWarning(&_logConfig, "Failed to remove proxy %u, not found.", proxy);
+        return;
+    }
+    // Compact the endpoint lists, preserving their order
+    for (int axis = 0; axis < 3; axis++)
+    {
+        SAPEndpoint *endpoints = sap->endpoints[axis];
+        size_t write = 0;
+        for (size_t read = 0; read < sap->endpoints_size; read++)
+        {
+            if (ENDPOINT_PROXY(endpoints[read].data) != proxy)
+            {
+                endpoints[write++] = endpoints[read];
+            }
+        }
+    }
+    sap->endpoints_size -= 2;
+    sap->proxies[proxy].inUse = false;
+    sap->proxies[proxy].rigidbody = NULL;
+    sap->freeProxies[sap->freeProxies_size++] = proxy;
+}
+
+void SweepAndPrune_UpdateProxy(SweepAndPrune *sap, uint32_t proxy, AABB aabb, uint32_t layerBit, uint32_t collisionMask, SAPMotion motion)
+{
+    SAPProxy *p = &sap->proxies[proxy];
+    p->aabb = aabb;
+    p->layerBit = layerBit;
+    p->collisionMask = collisionMask;
+    p->motion = motion;
+}
+
+// -------------------------
+// Update & Queries
+// -------------------------
+
+void SweepAndPrune_Update(SweepAndPrune *sap)
+{
+    V3 sum = V3_ZERO;
+    V3 sumSq = V3_ZERO;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        SAPEndpoint *endpoints = sap->endpoints[axis];
+        // Refresh values from the proxies, then restore order
+        for (size_t i = 0; i < sap->endpoints_size; i++)
+        {
+            endpoints[i].value = EndpointValue(&sap->proxies[ENDPOINT_PROXY(endpoints[i].data)], endpoints[i].data, axis);
+        }
+        InsertionSort(endpoints, sap->endpoints_size);
+    }
+
+    // Pick the axis where centers are most spread out, it yields the fewest false positives
+    size_t count = 0;
+    for (size_t i = 0; i < sap->proxies_size; i++)
+    {
+        if (!sap->proxies[i].inUse)
+            continue;
+        V3 center = V3_SCALE(V3_ADD(sap->proxies[i].aabb.min, sap->proxies[i].aabb.max), 0.5f);
+        sum = V3_ADD(sum, center);
+        sumSq = V3_ADD(sumSq, V3_MUL(center, center));
+        count++;
+    }
+    if (count == 0)
+        return;
+    float invCount = 1.0f / (float)count;
+    V3 mean = V3_SCALE(sum, invCount);
+    V3 variance = V3_SUB(V3_SCALE(sumSq, invCount), V3_MUL(mean, mean));
+    sap->sweepAxis = 0;
+    if (variance.y > variance.x)
+        sap->sweepAxis = 1;
+    if (variance.z > AABB_Axis(&variance, sap->sweepAxis))
+        sap->sweepAxis = 2;
+}
+
+size_t SweepAndPrune_FindPairs(SweepAndPrune *sap)
+{
+    sap->pairs_size = 0;
+    sap->active_size = 0;
+    int axis = sap->sweepAxis;
+    int axisB = (axis + 1) % 3;
+    int axisC = (axis + 2) % 3;
+    SAPEndpoint *endpoints = sap->endpoints[axis];
+
+    for (size_t i = 0; i < sap->endpoints_size; i++)
+    {
+        uint32_t proxy = ENDPOINT_PROXY(endpoints[i].data);
+        if (ENDPOINT_IS_MAX(endpoints[i].data))
+        {
+            // Interval closed - swap-remove from the active list
+            uint32_t slot = sap->activeSlot[proxy];
+            uint32_t last = sap->active[--sap->active_size];
+            sap->active[slot] = last;
+            sap->activeSlot[last] = slot;
+            continue;
+        }
+
+        // Interval opened - it overlaps every active interval on this axis
+        SAPProxy *a = &sap->proxies[proxy];
+        for (size_t j = 0; j < sap->active_size; j++)
+        {
+            uint32_t other = sap->active[j];
+            SAPProxy *b = &sap->proxies[other];
+            if (!ShouldPair(a, b))
+                continue;
+            if (!Overlap1D(a, b, axisB) || !Overlap1D(a, b, axisC))
+                continue;
+            // Keep a deterministic order inside the pair
+            if (other < proxy)
+                PushPair(sap, other, proxy);
+            else
+                PushPair(sap, proxy, other);
+        }
+        sap->activeSlot[proxy] = (uint32_t)sap->active_size;
+        sap->active[sap->active_size++] = proxy;
+    }
+    return sap->pairs_size;
+}
+
+// -------------------------
+// Creation & Freeing
+// -------------------------
+
+SweepAndPrune *SweepAndPrune_Create()
+{
+    SweepAndPrune *sap = malloc(sizeof(SweepAndPrune));
+    memset(sap, 0, sizeof(SweepAndPrune));
+    LogCreate(&_logConfig, "");
+    return sap;
+}
+
+void SweepAndPrune_Free(SweepAndPrune *sap)
+{
+    if (!sap)
+        return;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        free(sap->endpoints[axis]);
+    }
+    free(sap->proxies);
+    free(sap->freeProxies);
+    free(sap->active);
+    free(sap->activeSlot);
+    free(sap->pairs);
+    free(sap);
+    LogFree(&_logConfig, "");
+}
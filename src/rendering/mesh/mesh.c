@@ -1,6 +1,7 @@
 #include "rendering/mesh/mesh.h"
 #include "rendering/mesh/mesh-manager.h"
 #include "physics/mesh_bvh.h"
+#include "perceptron.h"
 // C
 #include <stdint.h>
 #include <stdlib.h>
@@ -22,6 +23,39 @@ static LogConfig _logConfig = {"Mesh", LOG_LEVEL_WARN, LOG_COLOR_BLUE};
 // Creation & Freeing
 // -------------------------
 
+/// @brief Create the mesh's vertex array and buffers and upload its CPU copy
+static void Mesh_Upload(Mesh *mesh)
+{
+    // Generate OpenGL objects
+    glGenVertexArrays(1, &mesh->VAO);
+    glGenBuffers(1, &mesh->VBO);
+    glGenBuffers(1, &mesh->EBO);
+    // Bind VAO (all vertex attribute state will be stored in this VAO)
+    glBindVertexArray(mesh->VAO);
+    // Upload vertices (use vertex_count * sizeof(Vertex))
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->VBO);
+    glBufferData(GL_ARRAY_BUFFER, mesh->vertices_size * sizeof(Vertex), mesh->vertices, GL_STATIC_DRAW);
+    // Upload indices (use index_count * sizeof(uint32_t))
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh->indices_size * sizeof(uint32_t), mesh->indices, GL_STATIC_DRAW);
+    // Set vertex attributes
+    // Position (location = 0) -> 3 floats
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, position));
+    // Normal (location = 1) -> 3 floats
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, normal));
+    // UV (location = 2) -> 2 floats
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, uv));
+    // Color (location = 3) -> 4 unsigned bytes normalized to float0..1
+    // If color is a packed uint32_t (RGBA), this interprets it as 4 bytes (A,B,G,R) depending on endianness.
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void *)offsetof(Vertex, color));
+    // Unbind VAO
+    glBindVertexArray(0);
+}
+
 void Mesh_Free(Mesh *mesh)
 {
     if (mesh->refCount > 0)
@@ -30,10 +64,14 @@ void Mesh_Free(Mesh *mesh)
         return;
     }
     Log(&_logConfig, "Freeing VAO: %u, VBO: %u, EBO: %u\n", mesh->VAO, mesh->VBO, mesh->EBO);
-    glDeleteVertexArrays(1, &mesh->VAO);
-    glDeleteBuffers(1, &mesh->VBO);
-    glDeleteBuffers(1, &mesh->EBO);
+    if (mesh->VAO)
+    {
+        glDeleteVertexArrays(1, &mesh->VAO);
+        glDeleteBuffers(1, &mesh->VBO);
+        glDeleteBuffers(1, &mesh->EBO);
+    }
 
+    MeshBVH_Free(mesh->bvh);
     free(mesh->vertices);
     free(mesh->indices);
     free(mesh);
@@ -61,34 +99,16 @@ Mesh *Mesh_Create(bool registerMesh, size_t vertices_size, Vertex *vertices, siz
     mesh->pivot = pivot;
     // Referencing
     mesh->refCount = 0;
-    // Generate OpenGL objects
-    glGenVertexArrays(1, &mesh->VAO);
-    glGenBuffers(1, &mesh->VBO);
-    glGenBuffers(1, &mesh->EBO);
-    // Bind VAO (all vertex attribute state will be stored in this VAO)
-    glBindVertexArray(mesh->VAO);
-    // Upload vertices (use vertex_count * sizeof(Vertex))
-    glBindBuffer(GL_ARRAY_BUFFER, mesh->VBO);
-    glBufferData(GL_ARRAY_BUFFER, mesh->vertices_size * sizeof(Vertex), mesh->vertices, GL_STATIC_DRAW);
-    // Upload indices (use index_count * sizeof(uint32_t))
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh->indices_size * sizeof(uint32_t), mesh->indices, GL_STATIC_DRAW);
-    // Set vertex attributes
-    // Position (location = 0) -> 3 floats
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, position));
-    // Normal (location = 1) -> 3 floats
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, normal));
-    // UV (location = 2) -> 2 floats
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)offsetof(Vertex, uv));
-    // Color (location = 3) -> 4 unsigned bytes normalized to float0..1
-    // If color is a packed uint32_t (RGBA), this interprets it as 4 bytes (A,B,G,R) depending on endianness.
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void *)offsetof(Vertex, color));
-    // Unbind VAO
-    glBindVertexArray(0);
+    // Physics
+    mesh->bvh = NULL;
+    // Headless meshes only keep their CPU copy, for colliders and queries
+    mesh->VAO = 0;
+    mesh->VBO = 0;
+    mesh->EBO = 0;
+    if (!Headless)
+    {
+        Mesh_Upload(mesh);
+    }
     // Register Mesh
     mesh->isRegistered = registerMesh;
     if (registerMesh)
@@ -876,6 +896,19 @@ void Mesh_MarkUnreferenced(Mesh *mesh)
     }
 }
 
+// -------------------------
+// Physics
+// -------------------------
+
+MeshBVH *Mesh_GetBVH(Mesh *mesh)
+{
+    if (!mesh->bvh)
+    {
+        mesh->bvh = MeshBVH_Create(mesh, MeshBVHBuildSettings_Default());
+    }
+    return mesh->bvh;
+}
+
 // -------------------------
 // Utilities
 // -------------------------
@@ -883,7 +916,14 @@ void Mesh_MarkUnreferenced(Mesh *mesh)
 /// @brief Helper function to update GPU buffers
 void Mesh_UpdateIndexBuffer(Mesh *mesh, size_t offset, size_t count, const uint32_t *data)
 {
-    if (!mesh || !mesh->EBO || !data)
+    if (!mesh || !data)
+        return;
+
+    // Edited indices reconnect triangles, refit the ones they describe (a changed triangle count rebuilds)
+    if (mesh->bvh && data == mesh->indices + offset)
+        MeshBVH_Refit(mesh->bvh, mesh, (uint32_t)(offset / 3), (uint32_t)((offset % 3 + count + 2) / 3));
+
+    if (!mesh->EBO)
         return;
     
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->EBO);
@@ -897,7 +937,14 @@ void Mesh_UpdateIndexBuffer(Mesh *mesh, size_t offset, size_t count, const uint3
 /// @brief Helper function to update GPU buffers
 void Mesh_UpdateVertexBuffer(Mesh *mesh, size_t offset, size_t count, const Vertex *data)
 {
-    if (!mesh || !mesh->VBO || !data)
+    if (!mesh || !data)
+        return;
+
+    // Uploading the CPU copy means it was edited, keep the physics tree in sync
+    if (mesh->bvh && data == mesh->vertices + offset)
+        MeshBVH_RefitVertices(mesh->bvh, mesh, (uint32_t)offset, (uint32_t)count);
+
+    if (!mesh->VBO)
         return;
     
     glBindBuffer(GL_ARRAY_BUFFER, mesh->VBO);
@@ -1,6 +1,7 @@
 #include "rendering/texture/texture-manager.h"
 #include "rendering/shader/shader-manager.h"
 #include "logging/logger.h"
+#include "perceptron.h"
 
 #include <stdlib.h>
 
@@ -111,10 +112,14 @@ ShaderManager *ShaderManager_Create()
     }
 
     // Initialize the Shader Global Data UBO
-    glGenBuffers(1, &manager->globalDataUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, manager->globalDataUBO);
-    glBufferData(GL_UNIFORM_BUFFER, sizeof(ShaderGlobalData), NULL, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 0, manager->globalDataUBO); // binding = 0 (Acts like a socket, all shaders listening to that have access to the data)
+    manager->globalDataUBO = 0;
+    if (!Headless)
+    {
+        glGenBuffers(1, &manager->globalDataUBO);
+        glBindBuffer(GL_UNIFORM_BUFFER, manager->globalDataUBO);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(ShaderGlobalData), NULL, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, 0, manager->globalDataUBO); // binding = 0 (Acts like a socket, all shaders listening to that have access to the data)
+    }
 
     // Create game shaders at start.
     ShaderManager_Select(manager);
@@ -225,6 +230,8 @@ void ShaderManager_UploadGlobalData()
     //         globalData->light_point_colors[i][3],
     //         globalData->light_point_positions[i][3]);
     // }
+    if (!_manager->globalDataUBO)
+        return;
     glBindBuffer(GL_UNIFORM_BUFFER, _manager->globalDataUBO);
     glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(ShaderGlobalData), globalData);
 }
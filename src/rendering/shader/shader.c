@@ -2,6 +2,7 @@
 #include "rendering/shader/shader-manager.h"
 #include "logging/logger.h"
 #include "utilities/file/file.h"
+#include "perceptron.h"
 #include <cglm/cglm.h>
 #include <stdlib.h>
 // OpenGL
@@ -58,6 +59,12 @@ inline static GLuint Shader_CreateShaderProgram(const char *vertSrc, const char
     return program;
 }
 
+/// @return -1 when headless, like a uniform the program does not use
+inline static GLint Shader_UniformLocation(Shader *shader, const char *name)
+{
+    return shader->shaderProgram ? glGetUniformLocation(shader->shaderProgram, name) : -1;
+}
+
 inline static void ShaderProperty_PartialInit(ShaderProperty *prop, const char *name, GLint loc, ShaderPropertyType type, bool isBig)
 {
     prop->name = malloc(sizeof(char) * 64);
@@ -95,12 +102,17 @@ Shader *Shader_LoadFromFile(char *name, char *vertexPath, char *fragmentPath, si
 
 Shader *Shader_Create(const char *name, const char *vertexSource, const char *fragmentSource, size_t properties_size)
 {
-    GLint shaderProgram = Shader_CreateShaderProgram(vertexSource, fragmentSource);
-    if (shaderProgram == 0)
+    // Headless shaders keep their name and properties for materials, but have no program
+    GLint shaderProgram = 0;
+    if (!Headless)
     {
-        LogError(&_logConfig, "Error Creating Shader %s", name);
+        shaderProgram = Shader_CreateShaderProgram(vertexSource, fragmentSource);
+        if (shaderProgram == 0)
+        {
+            LogError(&_logConfig, "Error Creating Shader %s", name);
+        }
+        LogSuccess(&_logConfig, "Shader program %s created successfully.\n", name);
     }
-    LogSuccess(&_logConfig, "Shader program %s created successfully.\n", name);
     Shader *shader = malloc(sizeof(Shader));
     shader->shaderProgram = shaderProgram;
     // ID
@@ -112,7 +124,7 @@ Shader *Shader_Create(const char *name, const char *vertexSource, const char *fr
     shader->properties_size = properties_size;
     shader->properties = malloc(sizeof(ShaderProperty) * properties_size);
     // Model Location
-    shader->modelLoc = glGetUniformLocation(shaderProgram, "model");
+    shader->modelLoc = Shader_UniformLocation(shader, "model");
     // Add to shader list
     ShaderManager_AddShader(shader);
     return shader;
@@ -120,7 +132,10 @@ Shader *Shader_Create(const char *name, const char *vertexSource, const char *fr
 
 void Shader_Free(Shader *shader)
 {
-    glDeleteProgram(shader->shaderProgram);
+    if (shader->shaderProgram)
+    {
+        glDeleteProgram(shader->shaderProgram);
+    }
     for (int i = 0; i < shader->properties_size; i++)
     {
         free(shader->properties[i].name);
@@ -141,91 +156,91 @@ void Shader_Free(Shader *shader)
 
 void ShaderProperty_InitDefault_Float(Shader *shader, int index, const char *name, float value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_FLOAT, false);
     shader->properties[index].smallValue_default.floatValue = value;
 }
 
 void ShaderProperty_InitDefault_Vec2(Shader *shader, int index, const char *name, vec2 value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_VEC2, false);
     memcpy(&shader->properties[index].smallValue_default.vec2Value, value, sizeof(vec2));
 }
 
 void ShaderProperty_InitDefault_Vec3(Shader *shader, int index, const char *name, vec3 value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_VEC3, false);
     memcpy(&shader->properties[index].smallValue_default.vec3Value, value, sizeof(vec3));
 }
 
 void ShaderProperty_InitDefault_Vec4(Shader *shader, int index, const char *name, vec4 value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_VEC4, false);
     memcpy(&shader->properties[index].smallValue_default.vec4Value, value, sizeof(vec4));
 }
 
 void ShaderProperty_InitDefault_Int(Shader *shader, int index, const char *name, int value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_INT, false);
     shader->properties[index].smallValue_default.intValue = value;
 }
 
 void ShaderProperty_InitDefault_IVec2(Shader *shader, int index, const char *name, ivec2 value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_IVEC2, false);
     memcpy(&shader->properties[index].smallValue_default.ivec2Value, value, sizeof(ivec2));
 }
 
 void ShaderProperty_InitDefault_IVec3(Shader *shader, int index, const char *name, ivec3 value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_IVEC3, false);
     memcpy(&shader->properties[index].smallValue_default.ivec3Value, value, sizeof(ivec3));
 }
 
 void ShaderProperty_InitDefault_IVec4(Shader *shader, int index, const char *name, ivec4 value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_IVEC4, false);
     memcpy(&shader->properties[index].smallValue_default.ivec4Value, value, sizeof(ivec4));
 }
 
 void ShaderProperty_InitDefault_UInt(Shader *shader, int index, const char *name, unsigned int value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_UINT, false);
     shader->properties[index].smallValue_default.uintValue = value;
 }
 
 void ShaderProperty_InitDefault_Mat2(Shader *shader, int index, const char *name, mat2 value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_MAT2, false);
     memcpy(&shader->properties[index].smallValue_default.mat2Value, value, sizeof(mat2));
 }
 
 void ShaderProperty_InitDefault_Mat3(Shader *shader, int index, const char *name, mat3 value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_MAT3, false);
     memcpy(&shader->properties[index].smallValue_default.mat3Value, value, sizeof(mat3));
 }
 
 void ShaderProperty_InitDefault_Sampler2D(Shader *shader, int index, const char *name, GLuint textureID)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_SAMPLER2D, false);
     shader->properties[index].smallValue_default.sampler2DValue = textureID;
 }
 
 void ShaderProperty_InitDefault_Mat4(Shader *shader, int index, const char *name, mat4 value)
 {
-    GLint loc = glGetUniformLocation(shader->shaderProgram, name);
+    GLint loc = Shader_UniformLocation(shader, name);
     ShaderProperty_PartialInit(&shader->properties[index], name, loc, MPT_MAT4, false);
     shader->properties[index].bigValue_default = (ShaderPropBigValue){
         .size = sizeof(mat4),
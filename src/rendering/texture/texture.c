@@ -1,5 +1,6 @@
 #include "rendering/texture/texture.h"
 #include "rendering/texture/texture-manager.h"
+#include "perceptron.h"
 // C
 #include <stdlib.h>
 #include <stdio.h>
@@ -16,6 +17,9 @@ void Texture_FreeFromGPU(Texture *texture)
 void Texture_UploadToGPU(Texture *texture)
 {
     Texture_FreeFromGPU(texture);
+    // Headless textures stay on the CPU, textureID 0 like a texture that was never uploaded
+    if (Headless)
+        return;
     glGenTextures(1, &texture->textureID);
     glBindTexture(GL_TEXTURE_2D, texture->textureID);
     printf("Uploading texture: %dx%d, textureID: %u, data ptr: %p\n", 
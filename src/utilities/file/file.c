@@ -1,5 +1,16 @@
 #include "utilities/file/file.h"
 #include "logging/logger.h"
+// Platform
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <errno.h>
 
 static LogConfig _logConfig = {"File", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
 
@@ -82,4 +93,81 @@ unsigned char *File_LoadBinary(const char *filename)
 
     fclose(file);
     return buffer;
-}
\ No newline at end of file
+}
+
+void *File_Map(const char *filename, size_t *outSize)
+{
+    *outSize = 0;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length) || length.QuadPart <= 0)
+    {
+        CloseHandle(file);
+        return NULL;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping)
+        return NULL;
+    void *data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    // The view keeps the mapping alive
+    CloseHandle(mapping);
+    if (!data)
+    {
+        LogError(&_logConfig, "Error: Could not map file %s\n", filename);
+        return NULL;
+    }
+    *outSize = (size_t)length.QuadPart;
+    return data;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        close(fd);
+        return NULL;
+    }
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file alive
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        LogError(&_logConfig, "Error: Could not map file %s\n", filename);
+        return NULL;
+    }
+    *outSize = (size_t)info.st_size;
+    return data;
+#endif
+}
+
+void File_Unmap(void *data, size_t size)
+{
+    if (!data)
+        return;
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+bool File_CreateDirectory(const char *path)
+{
+#ifdef _WIN32
+    int result = _mkdir(path);
+#else
+    int result = mkdir(path, 0755);
+#endif
+    if (result != 0 && errno != EEXIST)
+    {
+        LogError(&_logConfig, "Error: Could not create directory %s\n", path);
+        return false;
+    }
+    return true;
+}
@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <math.h>
 #include "rendering/texture/texture.h"
+#include "physics/heightfield.h"
 
 typedef enum
 {
@@ -298,21 +299,14 @@ static NoiseLayer *NoiseLayer_Get(Noise *noise, size_t layers_size, const NoiseL
     return &layers[lowestLayer];
 }
 
-inline float Noise_GetMeshHeightAt(Noise *noise, V3 positionIslandSpace, V3 meshScale, V3 pivot)
+Heightfield *Noise_CreateHeightfield(Noise *noise, V3 meshScale, V3 pivot)
 {
-    float dy = meshScale.y / (float)(noise->max - noise->min);
-    float yOffset = -pivot.y * meshScale.y;
-    // printf("Pivot: %f, %f, %f, LocalPos originally: %.2f, %.2f\n", pivot.x, pivot.y, pivot.z, positionIslandSpace.x, positionIslandSpace.z);
-    positionIslandSpace.x += pivot.x * meshScale.x;
-    positionIslandSpace.z += pivot.z * meshScale.z;
-    // printf("Transformed local pos: %.2f, %.2f\n", positionIslandSpace.x, positionIslandSpace.z);
-    int x = (int)(positionIslandSpace.x / meshScale.x * (float)(noise->width - 1));
-    int y = (int)(positionIslandSpace.z / meshScale.z * (float)(noise->height - 1));
-    // printf("MeshScale: %f, %f, %f Player local pos: %.2f, %.2f -> Noise coords: %d, %d\n", meshScale.x, meshScale.y, meshScale.z, positionIslandSpace.x, positionIslandSpace.z, x, y);
-    if(x < 0 || x >= noise->width || y < 0 || y >= noise->height){
-        return positionIslandSpace.y;
-    }
-    return noise->map[x][y] * dy + yOffset;
+    V3 spacing = {
+        meshScale.x / (float)noise->width,
+        meshScale.y / (float)(noise->max - noise->min),
+        meshScale.z / (float)noise->height};
+    V3 origin = V3_SCALE(V3_MUL(pivot, meshScale), -1.0f);
+    return Heightfield_Create(noise->map, noise->width, noise->height, origin, spacing);
 }
 
 Mesh *Noise_CreateMesh(Noise *noise, V3 meshScale, int layers_size, const NoiseLayer *layers, bool usePixelColors, Texture *texture, int density, V3 pivot)
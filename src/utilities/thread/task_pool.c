@@ -0,0 +1,218 @@
+#include "utilities/thread/task_pool.h"
+// C
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+// Platform
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+// Logging
+#include "logging/logger.h"
+
+// -------------------------
+// Static Variables
+// -------------------------
+
+static LogConfig _logConfig = {"TaskPool", LOG_LEVEL_INFO, LOG_COLOR_BLUE};
+static TaskPool *_pool = NULL;
+
+// -------------------------
+// Types
+// -------------------------
+
+typedef struct ParallelFor
+{
+    TaskRangeFunction function;
+    void *data;
+    size_t count;
+    size_t chunk_size;
+    /// @brief First item of the next unclaimed chunk
+    atomic_size_t next;
+} ParallelFor;
+
+// -------------------------
+// Helpers
+// -------------------------
+
+/// @brief Run a popped task, the mutex must not be held. Returns with the mutex held.
+static void RunTask(TaskPool *pool, Task task)
+{
+    task.function(task.data);
+    pthread_mutex_lock(&pool->mutex);
+    if (--task.group->pending == 0)
+        pthread_cond_broadcast(&pool->groupDone);
+}
+
+/// @brief Claim and run chunks until none are left
+static void RunChunks(void *data)
+{
+    ParallelFor *parallelFor = data;
+    size_t begin;
+    while ((begin = atomic_fetch_add(&parallelFor->next, parallelFor->chunk_size)) < parallelFor->count)
+    {
+        size_t end = begin + parallelFor->chunk_size;
+        if (end > parallelFor->count)
+            end = parallelFor->count;
+        parallelFor->function(parallelFor->data, begin, end);
+    }
+}
+
+static void *WorkerLoop(void *data)
+{
+    TaskPool *pool = data;
+    pthread_mutex_lock(&pool->mutex);
+    while (true)
+    {
+        while (pool->tasks_size == 0 && !pool->stopping)
+            pthread_cond_wait(&pool->taskQueued, &pool->mutex);
+        if (pool->tasks_size == 0)
+            break;
+        Task task = pool->tasks[--pool->tasks_size];
+        pthread_mutex_unlock(&pool->mutex);
+        RunTask(pool, task);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+// -------------------------
+// Creation and Freeing
+// -------------------------
+
+TaskPool *TaskPool_Create(uint32_t workers_size)
+{
+    TaskPool *pool = malloc(sizeof(TaskPool));
+    memset(pool, 0, sizeof(TaskPool));
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->taskQueued, NULL);
+    pthread_cond_init(&pool->groupDone, NULL);
+    pool->workers = malloc(sizeof(pthread_t) * (workers_size > 0 ? workers_size : 1));
+    for (uint32_t i = 0; i < workers_size; i++)
+    {
+        if (pthread_create(&pool->workers[pool->workers_size], NULL, WorkerLoop, pool) != 0)
+        {
+            LogError(&_logConfig, "Failed to start worker %u", i);
+            break;
+        }
+        pool->workers_size++;
+    }
+    TaskPool_Select(pool);
+    LogCreate(&_logConfig, "%u workers", pool->workers_size);
+    return pool;
+}
+
+void TaskPool_Free(TaskPool *pool)
+{
+    if (!pool)
+        return;
+    pthread_mutex_lock(&pool->mutex);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->taskQueued);
+    pthread_mutex_unlock(&pool->mutex);
+    for (uint32_t i = 0; i < pool->workers_size; i++)
+    {
+        pthread_join(pool->workers[i], NULL);
+    }
+    pthread_cond_destroy(&pool->taskQueued);
+    pthread_cond_destroy(&pool->groupDone);
+    pthread_mutex_destroy(&pool->mutex);
+    free(pool->workers);
+    free(pool->tasks);
+    if (_pool == pool)
+        _pool = NULL;
+    free(pool);
+    LogFree(&_logConfig, "");
+}
+
+// -------------------------
+// Functions
+// -------------------------
+
+void TaskPool_Select(TaskPool *pool)
+{
+    _pool = pool;
+}
+
+TaskPool *TaskPool_Get()
+{
+    return _pool;
+}
+
+uint32_t TaskPool_HardwareThreads()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    long count = (long)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+void TaskPool_Submit(TaskPool *pool, TaskGroup *group, TaskFunction function, void *data)
+{
+    if (!pool || pool->workers_size == 0)
+    {
+        function(data);
+        return;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    if (pool->tasks_size >= pool->tasks_capacity)
+    {
+        pool->tasks_capacity = pool->tasks_capacity == 0 ? 64 : pool->tasks_capacity * 2;
+        pool->tasks = realloc(pool->tasks, sizeof(Task) * pool->tasks_capacity);
+    }
+    pool->tasks[pool->tasks_size++] = (Task){function, data, group};
+    group->pending++;
+    pthread_cond_signal(&pool->taskQueued);
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+void TaskPool_Wait(TaskPool *pool, TaskGroup *group)
+{
+    if (!pool || pool->workers_size == 0)
+        return;
+    pthread_mutex_lock(&pool->mutex);
+    while (group->pending > 0)
+    {
+        // Help out instead of sleeping, waiting tasks would otherwise starve the pool
+        if (pool->tasks_size > 0)
+        {
+            Task task = pool->tasks[--pool->tasks_size];
+            pthread_mutex_unlock(&pool->mutex);
+            RunTask(pool, task);
+            continue;
+        }
+        pthread_cond_wait(&pool->groupDone, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+void TaskPool_ParallelFor(TaskPool *pool, size_t count, size_t chunk_size, TaskRangeFunction function, void *data)
+{
+    if (count == 0)
+        return;
+    if (chunk_size == 0)
+        chunk_size = 1;
+    if (!pool || pool->workers_size == 0 || count <= chunk_size)
+    {
+        function(data, 0, count);
+        return;
+    }
+    ParallelFor parallelFor = {function, data, count, chunk_size};
+    atomic_init(&parallelFor.next, 0);
+    // One runner per worker at most, the calling thread is the last one
+    size_t chunks = (count + chunk_size - 1) / chunk_size;
+    size_t helpers = chunks - 1 < pool->workers_size ? chunks - 1 : pool->workers_size;
+    TaskGroup group = {0};
+    for (size_t i = 0; i < helpers; i++)
+    {
+        TaskPool_Submit(pool, &group, RunChunks, &parallelFor);
+    }
+    RunChunks(&parallelFor);
+    TaskPool_Wait(pool, &group);
+}
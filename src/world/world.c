@@ -256,8 +256,11 @@ void World_Free(World *world, bool resizeWorlds)
     }
     // Skybox
     Mesh_MarkUnreferenced(world->skyboxMesh);
-    // Free Entities
+    // Free Entities, their rigidbodies leave this world's physics manager
+    PhysicsManager_Select(world->physicsManager);
     Entity_Free(world->parent, false);
+    // Physics, stops its thread
+    PhysicsManager_Free(world->physicsManager);
     // Free struct
     free(world->meshRenderers);
     free(world->lights_directional);